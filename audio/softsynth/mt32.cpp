@@ -36,7 +36,10 @@
 #include "common/error.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/mutex.h"
+#include "common/queue.h"
 #include "common/system.h"
+#include "common/timer.h"
 #include "common/util.h"
 #include "common/archive.h"
 #include "common/textconsole.h"
@@ -97,6 +100,11 @@ class MidiChannel_MT32 : public MidiChannel_MPU401 {
 	void chorusLevel(byte value) { }
 };
 
+struct MidiEvent_MT32 {
+	uint32 msg; // 0xFFFFFFFF indicates a sysex message
+	Common::Array<byte> data;
+};
+
 class MidiDriver_MT32 : public MidiDriver_Emulated {
 private:
 	MidiChannel_MT32 _midiChannels[16];
@@ -109,6 +117,35 @@ private:
 
 	int _outputRate;
 
+	// Render-ahead mode: the synth is run from a timer callback into a ring
+	// buffer, and the mixer callback only copies already rendered samples.
+	// MIDI messages are queued and applied by whoever renders next, so that
+	// senders never wait for the synth.
+	enum {
+		kRenderAheadBufferSize = 8192, // int16 samples, ~128ms of stereo output
+		kRenderAheadChunkSize = 640,   // int16 samples, 10ms of stereo output
+		kRenderAheadInterval = 10000,  // microseconds
+		kRenderAheadMaxChunks = 2      // chunks rendered per timer call at most
+	};
+
+	bool _renderAhead;
+	Common::Mutex _synthMutex;
+	Common::Mutex _bufferMutex;
+	Common::Mutex _eventMutex;
+	Common::Queue<MidiEvent_MT32> _events;
+	int16 *_renderBuffer;
+	uint32 _renderReadPos, _renderWritePos;
+	int16 _renderChunk[kRenderAheadChunkSize];
+	uint32 _underrunCount;
+
+	static void renderAheadTimerProc(void *refCon);
+	void renderAhead();
+	void pushEvent(const MidiEvent_MT32 &event);
+	void playQueuedEvents();
+	int readRenderedSamples(int16 *data, int numSamples);
+	void playMsg(uint32 b);
+	void playSysex(const byte *msg, uint16 length);
+
 protected:
 	void generateSamples(int16 *buf, int len);
 
@@ -129,6 +166,7 @@ public:
 	MidiChannel *getPercussionChannel();
 
 	// AudioStream API
+	int readBuffer(int16 *data, const int numSamples);
 	bool isStereo() const { return true; }
 	int getRate() const { return _outputRate; }
 };
@@ -156,6 +194,11 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	// rely on Mixer to convert.
 	_outputRate = 32000; //_mixer->getOutputRate();
 	_initializing = false;
+
+	_renderAhead = false;
+	_renderBuffer = NULL;
+	_renderReadPos = _renderWritePos = 0;
+	_underrunCount = 0;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -179,6 +222,9 @@ void MidiDriver_MT32::deleteMuntStructures() {
 	_controlFile = NULL;
 	delete _pcmFile;
 	_pcmFile = NULL;
+
+	delete[] _renderBuffer;
+	_renderBuffer = NULL;
 }
 
 int MidiDriver_MT32::open() {
@@ -227,12 +273,30 @@ int MidiDriver_MT32::open() {
 
 	g_system->updateScreen();
 
+	_renderAhead = ConfMan.getBool("mt32_render_ahead");
+	if (_renderAhead) {
+		_renderBuffer = new int16[kRenderAheadBufferSize];
+		_renderReadPos = _renderWritePos = 0;
+		_underrunCount = 0;
+		g_system->getTimerManager()->installTimerProc(&renderAheadTimerProc, kRenderAheadInterval, this, "MT32renderAhead");
+	}
+
 	_mixer->playStream(Audio::Mixer::kSFXSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
 }
 
 void MidiDriver_MT32::send(uint32 b) {
+	if (_renderAhead) {
+		MidiEvent_MT32 event;
+		event.msg = b;
+		pushEvent(event);
+	} else {
+		playMsg(b);
+	}
+}
+
+void MidiDriver_MT32::playMsg(uint32 b) {
 	_synth->playMsg(b);
 }
 
@@ -254,6 +318,18 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 }
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
+	if (_renderAhead) {
+		MidiEvent_MT32 event;
+		event.msg = 0xFFFFFFFF;
+		event.data.resize(length);
+		memcpy(event.data.begin(), msg, length);
+		pushEvent(event);
+	} else {
+		playSysex(msg, length);
+	}
+}
+
+void MidiDriver_MT32::playSysex(const byte *msg, uint16 length) {
 	if (msg[0] == 0xf0) {
 		_synth->playSysex(msg, length);
 	} else {
@@ -271,157 +347,136 @@ void MidiDriver_MT32::close() {
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	if (_renderAhead) {
+		g_system->getTimerManager()->removeTimerProc(&renderAheadTimerProc);
+		debug(1, "MT32emu: %d render-ahead buffer underruns", _underrunCount);
+
+		Common::StackLock lock(_eventMutex);
+		_events.clear();
+		_renderAhead = false;
+	}
+
 	_synth->close();
 	deleteMuntStructures();
 }
 
 void MidiDriver_MT32::generateSamples(int16 *data, int len) {
+	if (_renderAhead)
+		playQueuedEvents();
+
 	_synth->render(data, len);
 }
 
-uint32 MidiDriver_MT32::property(int prop, uint32 param) {
-	switch (prop) {
-	case PROP_CHANNEL_MASK:
-		_channelMask = param & 0xFFFF;
-		return 1;
-	}
+int MidiDriver_MT32::readBuffer(int16 *data, const int numSamples) {
+	if (!_renderAhead)
+		return MidiDriver_Emulated::readBuffer(data, numSamples);
 
-	return 0;
-}
+	int samples = readRenderedSamples(data, numSamples);
 
-MidiChannel *MidiDriver_MT32::allocateChannel() {
-	MidiChannel_MT32 *chan;
-	uint i;
+	if (samples < numSamples) {
+		// Wait for the chunk being rendered, it may have just what we need
+		Common::StackLock lock(_synthMutex);
+		samples += readRenderedSamples(data + samples, numSamples - samples);
 
-	for (i = 0; i < ARRAYSIZE(_midiChannels); ++i) {
-		if (i == 9 || !(_channelMask & (1 << i)))
-			continue;
-		chan = &_midiChannels[i];
-		if (chan->allocate()) {
-			return chan;
+		if (samples < numSamples) {
+			// Underrun: render the rest right here, as in the normal mode
+			_underrunCount++;
+			debug(5, "MT32emu: Render-ahead buffer underrun (%d samples missing)", numSamples - samples);
+			MidiDriver_Emulated::readBuffer(data + samples, numSamples - samples);
 		}
 	}
-	return NULL;
-}
 
-MidiChannel *MidiDriver_MT32::getPercussionChannel() {
-	return &_midiChannels[9];
+	return numSamples;
 }
 
-// This code should be used when calling the timer callback from the mixer thread is undesirable.
-// Note that it results in less accurate timing.
-#if 0
-class MidiEvent_MT32 {
-public:
-	MidiEvent_MT32 *_next;
-	uint32 _msg; // 0xFFFFFFFF indicates a sysex message
-	byte *_data;
-	uint32 _len;
-
-	MidiEvent_MT32(uint32 msg, byte *data, uint32 len) {
-		_msg = msg;
-		if (len > 0) {
-			_data = new byte[len];
-			memcpy(_data, data, len);
-		}
-		_len = len;
-		_next = NULL;
-	}
+void MidiDriver_MT32::renderAheadTimerProc(void *refCon) {
+	((MidiDriver_MT32 *)refCon)->renderAhead();
+}
 
-	MidiEvent_MT32() {
-		if (_len > 0)
-			delete _data;
+void MidiDriver_MT32::renderAhead() {
+	// Render one chunk at a time, so that a mixer underrun or the other
+	// timer callbacks never wait for more than a single chunk. Rendering
+	// twice the timer interval per call is enough to fill up the buffer
+	// over a few calls.
+	for (int chunk = 0; chunk < kRenderAheadMaxChunks; chunk++) {
+		Common::StackLock lock(_synthMutex);
+
+		_bufferMutex.lock();
+		uint32 fill = _renderWritePos - _renderReadPos;
+		_bufferMutex.unlock();
+
+		// The mixer only ever frees space in the meantime, so it is safe
+		// to render without looking at the read position again
+		if (fill + kRenderAheadChunkSize > kRenderAheadBufferSize)
+			break;
+
+		MidiDriver_Emulated::readBuffer(_renderChunk, kRenderAheadChunkSize);
+
+		Common::StackLock bufferLock(_bufferMutex);
+		for (uint32 i = 0; i < kRenderAheadChunkSize; i++)
+			_renderBuffer[(_renderWritePos + i) % kRenderAheadBufferSize] = _renderChunk[i];
+		_renderWritePos += kRenderAheadChunkSize;
 	}
-};
-
-class MidiDriver_ThreadedMT32 : public MidiDriver_MT32 {
-private:
-	OSystem::Mutex _eventMutex;
-	MidiEvent_MT32 *_events;
-	TimerManager::TimerProc _timer_proc;
-
-	void pushMidiEvent(MidiEvent_MT32 *event);
-	MidiEvent_MT32 *popMidiEvent();
-
-protected:
-	void send(uint32 b);
-	void sysEx(const byte *msg, uint16 length);
-
-public:
-	MidiDriver_ThreadedMT32(Audio::Mixer *mixer);
+}
 
-	void onTimer();
-	void close();
-	void setTimerCallback(void *timer_param, TimerManager::TimerProc timer_proc);
-};
+int MidiDriver_MT32::readRenderedSamples(int16 *data, int numSamples) {
+	Common::StackLock lock(_bufferMutex);
 
+	int samples = MIN<int>(numSamples, _renderWritePos - _renderReadPos);
 
-MidiDriver_ThreadedMT32::MidiDriver_ThreadedMT32(Audio::Mixer *mixer) : MidiDriver_MT32(mixer) {
-	_events = NULL;
-	_timer_proc = NULL;
-}
+	for (int i = 0; i < samples; i++)
+		data[i] = _renderBuffer[(_renderReadPos + i) % kRenderAheadBufferSize];
+	_renderReadPos += samples;
 
-void MidiDriver_ThreadedMT32::close() {
-	MidiDriver_MT32::close();
-	while ((popMidiEvent() != NULL)) {
-		// Just eat any leftover events
-	}
+	return samples;
 }
 
-void MidiDriver_ThreadedMT32::setTimerCallback(void *timer_param, TimerManager::TimerProc timer_proc) {
-	if (!_timer_proc || !timer_proc) {
-		if (_timer_proc)
-			_vm->_timer->removeTimerProc(_timer_proc);
-		_timer_proc = timer_proc;
-		if (timer_proc)
-			_vm->_timer->installTimerProc(timer_proc, getBaseTempo(), timer_param, "MT32tempo");
-	}
+void MidiDriver_MT32::pushEvent(const MidiEvent_MT32 &event) {
+	Common::StackLock lock(_eventMutex);
+	_events.push(event);
 }
 
-void MidiDriver_ThreadedMT32::pushMidiEvent(MidiEvent_MT32 *event) {
+void MidiDriver_MT32::playQueuedEvents() {
 	Common::StackLock lock(_eventMutex);
-	if (_events == NULL) {
-		_events = event;
-	} else {
-		MidiEvent_MT32 *last = _events;
-		while (last->_next != NULL)
-			last = last->_next;
-		last->_next = event;
+
+	while (!_events.empty()) {
+		MidiEvent_MT32 event = _events.pop();
+
+		if (event.msg == 0xFFFFFFFF)
+			playSysex(event.data.begin(), event.data.size());
+		else
+			playMsg(event.msg);
 	}
 }
 
-MidiEvent_MT32 *MidiDriver_ThreadedMT32::popMidiEvent() {
-	Common::StackLock lock(_eventMutex);
-	MidiEvent_MT32 *event;
-	event = _events;
-	if (event != NULL)
-		_events = event->_next;
-	return event;
-}
+uint32 MidiDriver_MT32::property(int prop, uint32 param) {
+	switch (prop) {
+	case PROP_CHANNEL_MASK:
+		_channelMask = param & 0xFFFF;
+		return 1;
+	}
 
-void MidiDriver_ThreadedMT32::send(uint32 b) {
-	MidiEvent_MT32 *event = new MidiEvent_MT32(b, NULL, 0);
-	pushMidiEvent(event);
+	return 0;
 }
 
-void MidiDriver_ThreadedMT32::sysEx(const byte *msg, uint16 length) {
-	MidiEvent_MT32 *event = new MidiEvent_MT32(0xFFFFFFFF, msg, length);
-	pushMidiEvent(event);
-}
+MidiChannel *MidiDriver_MT32::allocateChannel() {
+	MidiChannel_MT32 *chan;
+	uint i;
 
-void MidiDriver_ThreadedMT32::onTimer() {
-	MidiEvent_MT32 *event;
-	while ((event = popMidiEvent()) != NULL) {
-		if (event->_msg == 0xFFFFFFFF) {
-			MidiDriver_MT32::sysEx(event->_data, event->_len);
-		} else {
-			MidiDriver_MT32::send(event->_msg);
+	for (i = 0; i < ARRAYSIZE(_midiChannels); ++i) {
+		if (i == 9 || !(_channelMask & (1 << i)))
+			continue;
+		chan = &_midiChannels[i];
+		if (chan->allocate()) {
+			return chan;
 		}
-		delete event;
 	}
+	return NULL;
 }
-#endif
 
+MidiChannel *MidiDriver_MT32::getPercussionChannel() {
+	return &_midiChannels[9];
+}
 
 // Plugin interface
 
@@ -176,6 +176,15 @@ public:
 	 * @return pointer to the stream object, 0 in case of a failure
 	 */
 	virtual Common::WriteStream *createWriteStream() = 0;
+
+	/**
+	 * Creates a WriteStream instance which replaces the file referred by
+	 * this node once it is finalized or deleted without errors. Backends
+	 * which cannot replace files atomically write to the file directly.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::WriteStream *createAtomicWriteStream() { return createWriteStream(); }
 };
 
 
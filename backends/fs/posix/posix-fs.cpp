@@ -250,4 +250,8 @@ Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
 
+Common::WriteStream *POSIXFilesystemNode::createAtomicWriteStream() {
+	return StdioStream::makeForReplacing(getPath());
+}
+
 #endif //#if defined(POSIX)
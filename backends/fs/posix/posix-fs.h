@@ -72,6 +72,7 @@ public:
 
 	virtual Common::SeekableReadStream *createReadStream();
 	virtual Common::WriteStream *createWriteStream();
+	virtual Common::WriteStream *createAtomicWriteStream();
 
 private:
 	/**
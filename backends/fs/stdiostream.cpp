@@ -27,12 +27,21 @@
 
 #include "backends/fs/stdiostream.h"
 
+#if defined(POSIX)
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(WIN32) && !defined(_WIN32_WCE)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
 StdioStream::StdioStream(void *handle) : _handle(handle) {
 	assert(handle);
 }
 
 StdioStream::~StdioStream() {
-	fclose((FILE *)_handle);
+	if (_handle)
+		fclose((FILE *)_handle);
 }
 
 bool StdioStream::err() const {
@@ -103,4 +112,84 @@ StdioStream *StdioStream::makeFromPath(const Common::String &path, bool writeMod
 	return 0;
 }
 
+StdioStream *StdioStream::makeForReplacing(const Common::String &path) {
+#if defined(_WIN32_WCE)
+	// There is no way to replace a file atomically
+	return makeFromPath(path, true);
+#else
+	Common::String target = path;
+
+#if defined(POSIX)
+	// Replace the file a symbolic link points to, not the link itself
+	char *resolved = realpath(path.c_str(), NULL);
+	if (resolved) {
+		target = resolved;
+		free(resolved);
+	}
+#endif
+
+	const Common::String tempPath = target + ".new";
+	FILE *handle = fopen(tempPath.c_str(), "wb");
+
+	// The directory might not be writable, while the file itself is
+	if (!handle)
+		return makeFromPath(path, true);
+
+#if defined(POSIX)
+	// Keep the permissions of the file being replaced
+	struct stat st;
+	if (stat(target.c_str(), &st) == 0)
+		fchmod(fileno(handle), st.st_mode & 07777);
+#endif
+
+	return new StdioReplaceStream(handle, target, tempPath);
+#endif
+}
+
+StdioReplaceStream::StdioReplaceStream(void *handle, const Common::String &path, const Common::String &tempPath)
+	: StdioStream(handle), _path(path), _tempPath(tempPath), _failed(false) {
+}
+
+StdioReplaceStream::~StdioReplaceStream() {
+	finalize();
+}
+
+bool StdioReplaceStream::err() const {
+	if (!_handle)
+		return _failed;
+
+	return StdioStream::err();
+}
+
+void StdioReplaceStream::finalize() {
+	if (!_handle)
+		return;
+
+	FILE *handle = (FILE *)_handle;
+	bool success = fflush(handle) == 0 && !ferror(handle);
+
+#if defined(POSIX)
+	// Make sure the data is on the disk before the old file is replaced
+	success = success && fsync(fileno(handle)) == 0;
+#endif
+
+	if (fclose(handle) != 0)
+		success = false;
+	_handle = 0;
+
+	if (success) {
+#if defined(WIN32) && !defined(_WIN32_WCE)
+		// rename() does not replace existing files on Windows
+		success = MoveFileExA(_tempPath.c_str(), _path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		success = rename(_tempPath.c_str(), _path.c_str()) == 0;
+#endif
+	}
+
+	if (!success)
+		remove(_tempPath.c_str());
+
+	_failed = !success;
+}
+
 #endif
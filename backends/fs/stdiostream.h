@@ -40,6 +40,14 @@ public:
 	 */
 	static StdioStream *makeFromPath(const Common::String &path, bool writeMode);
 
+	/**
+	 * Opens a temporary file next to the file at the given path for
+	 * writing, which replaces that file once the stream is finalized or
+	 * deleted without errors. Where files cannot be replaced atomically,
+	 * or no temporary file can be created, the file is written directly.
+	 */
+	static StdioStream *makeForReplacing(const Common::String &path);
+
 	StdioStream(void *handle);
 	virtual ~StdioStream();
 
@@ -56,4 +64,22 @@ public:
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
 };
 
+/**
+ * A StdioStream writing to a temporary file, which is moved over the target
+ * file once the stream is finalized. Nothing can be written after that.
+ */
+class StdioReplaceStream : public StdioStream {
+public:
+	StdioReplaceStream(void *handle, const Common::String &path, const Common::String &tempPath);
+	virtual ~StdioReplaceStream();
+
+	virtual bool err() const;
+	virtual void finalize();
+
+private:
+	Common::String _path;
+	Common::String _tempPath;
+	bool _failed;
+};
+
 #endif
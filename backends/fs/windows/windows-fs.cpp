@@ -243,4 +243,8 @@ Common::WriteStream *WindowsFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
 
+Common::WriteStream *WindowsFilesystemNode::createAtomicWriteStream() {
+	return StdioStream::makeForReplacing(getPath());
+}
+
 #endif //#ifdef WIN32
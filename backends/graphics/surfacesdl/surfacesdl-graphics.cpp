@@ -138,7 +138,10 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	_enableFocusRectDebugCode(false), _enableFocusRect(false), _focusRect(),
 #endif
-	_transactionMode(kTransactionNone) {
+	_transactionMode(kTransactionNone),
+	_queuedScalerJobs(0), _numScalerJobs(0), _nextScalerJob(0), _pendingScalerJobs(0),
+	_numScalerThreads(0), _scalerMutex(0), _scalerWorkCond(0), _scalerDoneCond(0),
+	_scalerThreadsShouldQuit(false) {
 
 	if (SDL_InitSubSystem(SDL_INIT_VIDEO) == -1) {
 		error("Could not initialize SDL: %s", SDL_GetError());
@@ -188,6 +191,8 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 #else
 	_videoMode.fullscreen = true;
 #endif
+
+	initScalerThreads();
 }
 
 SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
@@ -195,6 +200,8 @@ SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
 	if (g_system->getEventManager()->getEventDispatcher() != NULL)
 		g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
 
+	deinitScalerThreads();
+
 	unloadGFXMode();
 	if (_mouseSurface)
 		SDL_FreeSurface(_mouseSurface);
@@ -953,6 +960,10 @@ void SurfaceSdlGraphicsManager::updateScreen() {
 	internUpdateScreen();
 }
 
+static bool rectsOverlap(const SDL_Rect &a, const SDL_Rect &b) {
+	return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
 void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	SDL_Surface *srcSurf, *origSurf;
 	int height, width;
@@ -1065,6 +1076,14 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwscreen->pitch;
 
+		// The dirty rects are scaled in batches which write to disjoint parts
+		// of the screen, since their bands may be scaled at the same time.
+		// With the aspect ratio correction each rect is stretched right
+		// after it is scaled, as stretching it moves its rows into those of
+		// the rects below it.
+		const bool stretch = _videoMode.aspectRatioCorrection && !_overlayVisible;
+		SDL_Rect *batch = _dirtyRectList;
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			register int dst_y = r->y + _currentShakePos;
 			register int dst_h = 0;
@@ -1079,24 +1098,39 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				orig_dst_y = dst_y;
 				dst_y = dst_y * scale1;
 
-				if (_videoMode.aspectRatioCorrection && !_overlayVisible)
+				if (stretch)
 					dst_y = real2Aspect(dst_y);
+			}
+
+			const SDL_Rect scaled = { (Sint16)rx1, (Sint16)dst_y, (Uint16)(r->w * scale1), (Uint16)(dst_h * scale1) };
+
+			if (dst_h > 0) {
+				for (SDL_Rect *queued = batch; queued != r; ++queued) {
+					if (rectsOverlap(*queued, scaled)) {
+						runScalerJobs();
+						batch = r;
+						break;
+					}
+				}
 
 				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h);
+				queueScalerJob(scalerProc, (byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
+					(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, scale1);
 			}
 
-			r->x = rx1;
-			r->y = dst_y;
-			r->w = r->w * scale1;
-			r->h = dst_h * scale1;
+			*r = scaled;
 
 #ifdef USE_SCALERS
-			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible)
+			if (stretch && dst_h > 0) {
+				runScalerJobs();
+				batch = r + 1;
 				r->h = stretch200To240((uint8 *) _hwscreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1);
+			}
 #endif
 		}
+
+		runScalerJobs();
+
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwscreen);
 
@@ -1330,6 +1364,160 @@ void SurfaceSdlGraphicsManager::fillScreen(uint32 col) {
 	unlockScreen();
 }
 
+void SurfaceSdlGraphicsManager::initScalerThreads() {
+	// The main thread scales too, so one thread means no worker threads
+	int threads = 1;
+	if (ConfMan.hasKey("scaler_threads"))
+		threads = CLIP<int>(ConfMan.getInt("scaler_threads"), 1, MAX_SCALER_THREADS);
+
+	if (threads == 1)
+		return;
+
+	_scalerMutex = SDL_CreateMutex();
+	_scalerWorkCond = SDL_CreateCond();
+	_scalerDoneCond = SDL_CreateCond();
+	_scalerThreadsShouldQuit = false;
+
+	for (_numScalerThreads = 0; _numScalerThreads < threads - 1; _numScalerThreads++) {
+		_scalerThreads[_numScalerThreads] = SDL_CreateThread(scalerThreadEntry, this);
+
+		if (!_scalerThreads[_numScalerThreads]) {
+			warning("Could not create scaler thread: %s", SDL_GetError());
+			break;
+		}
+	}
+}
+
+void SurfaceSdlGraphicsManager::deinitScalerThreads() {
+	if (!_scalerMutex)
+		return;
+
+	// Signal the worker threads to end, and wait for them to actually finish
+	SDL_LockMutex(_scalerMutex);
+	_scalerThreadsShouldQuit = true;
+	SDL_CondBroadcast(_scalerWorkCond);
+	SDL_UnlockMutex(_scalerMutex);
+
+	for (int i = 0; i < _numScalerThreads; i++)
+		SDL_WaitThread(_scalerThreads[i], NULL);
+	_numScalerThreads = 0;
+
+	SDL_DestroyCond(_scalerWorkCond);
+	SDL_DestroyCond(_scalerDoneCond);
+	SDL_DestroyMutex(_scalerMutex);
+	_scalerWorkCond = _scalerDoneCond = 0;
+	_scalerMutex = 0;
+}
+
+void SurfaceSdlGraphicsManager::queueScalerJob(ScalerProc *proc, const uint8 *src, uint32 srcPitch, uint8 *dst, uint32 dstPitch, int width, int height, int scale) {
+	int bands = 1;
+
+	// Split the area into bands for the worker threads, unless it is too
+	// small to be worth it
+	if (_numScalerThreads > 0)
+		bands = MIN(_numScalerThreads + 1, height / MIN_SCALER_BAND_HEIGHT);
+
+#if defined(USE_NASM) && defined(USE_HQ_SCALERS)
+	// The assembly versions of the HQ scalers keep their state in globals
+	if (proc == HQ2x || proc == HQ3x)
+		bands = 1;
+#endif
+
+	if (bands < 1)
+		bands = 1;
+
+	// Bands start on even rows, since some scalers (like DotMatrix) pick
+	// their pattern from the row parity relative to the start of the area
+	int y = 0;
+	for (int i = 0; i < bands; i++) {
+		int bandHeight = height - y;
+		if (i < bands - 1)
+			bandHeight = (bandHeight / (bands - i)) & ~1;
+
+		assert(_queuedScalerJobs < MAX_SCALER_JOBS);
+		ScalerJob &job = _scalerJobs[_queuedScalerJobs++];
+		job.proc = proc;
+		job.src = src + y * srcPitch;
+		job.srcPitch = srcPitch;
+		job.dst = dst + y * scale * dstPitch;
+		job.dstPitch = dstPitch;
+		job.width = width;
+		job.height = bandHeight;
+
+		y += bandHeight;
+	}
+}
+
+void SurfaceSdlGraphicsManager::runScalerJobs() {
+	if (_queuedScalerJobs == 0)
+		return;
+
+	if (_numScalerThreads == 0) {
+		for (int i = 0; i < _queuedScalerJobs; i++) {
+			const ScalerJob &job = _scalerJobs[i];
+			job.proc(job.src, job.srcPitch, job.dst, job.dstPitch, job.width, job.height);
+		}
+
+		_queuedScalerJobs = 0;
+		return;
+	}
+
+	// Only now hand the queued jobs to the worker threads
+	SDL_LockMutex(_scalerMutex);
+	_nextScalerJob = 0;
+	_numScalerJobs = _pendingScalerJobs = _queuedScalerJobs;
+	SDL_CondBroadcast(_scalerWorkCond);
+
+	// Help out with the scaling until all jobs are taken
+	while (_nextScalerJob < _numScalerJobs) {
+		const ScalerJob &job = _scalerJobs[_nextScalerJob++];
+
+		SDL_UnlockMutex(_scalerMutex);
+		job.proc(job.src, job.srcPitch, job.dst, job.dstPitch, job.width, job.height);
+		SDL_LockMutex(_scalerMutex);
+
+		_pendingScalerJobs--;
+	}
+
+	// Then wait for the worker threads to finish theirs
+	while (_pendingScalerJobs > 0)
+		SDL_CondWait(_scalerDoneCond, _scalerMutex);
+
+	_numScalerJobs = _nextScalerJob = 0;
+	SDL_UnlockMutex(_scalerMutex);
+
+	_queuedScalerJobs = 0;
+}
+
+void SurfaceSdlGraphicsManager::scalerThread() {
+	SDL_LockMutex(_scalerMutex);
+	while (true) {
+		// Wait till there is something to scale
+		while (!_scalerThreadsShouldQuit && _nextScalerJob >= _numScalerJobs)
+			SDL_CondWait(_scalerWorkCond, _scalerMutex);
+
+		if (_scalerThreadsShouldQuit)
+			break;
+
+		const ScalerJob &job = _scalerJobs[_nextScalerJob++];
+
+		SDL_UnlockMutex(_scalerMutex);
+		job.proc(job.src, job.srcPitch, job.dst, job.dstPitch, job.width, job.height);
+		SDL_LockMutex(_scalerMutex);
+
+		if (--_pendingScalerJobs == 0)
+			SDL_CondSignal(_scalerDoneCond);
+	}
+	SDL_UnlockMutex(_scalerMutex);
+}
+
+int SDLCALL SurfaceSdlGraphicsManager::scalerThreadEntry(void *arg) {
+	SurfaceSdlGraphicsManager *graphicsManager = (SurfaceSdlGraphicsManager *)arg;
+	assert(graphicsManager);
+	graphicsManager->scalerThread();
+	return 0;
+}
+
 void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool realCoordinates) {
 	if (_forceFull)
 		return;
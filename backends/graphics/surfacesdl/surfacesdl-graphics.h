@@ -246,6 +246,44 @@ protected:
 	SDL_Rect _dirtyRectList[NUM_DIRTY_RECT];
 	int _numDirtyRects;
 
+	/**
+	 * A band of rows to be run through the scaler. The scalers also read
+	 * the rows and columns around a band from the source, which is not
+	 * written to while scaling. The bands of one runScalerJobs() call write
+	 * to disjoint parts of the screen, so they can be scaled in any order
+	 * and on any thread.
+	 */
+	struct ScalerJob {
+		ScalerProc *proc;
+		const uint8 *src;
+		uint32 srcPitch;
+		uint8 *dst;
+		uint32 dstPitch;
+		int width, height;
+	};
+
+	enum {
+		MAX_SCALER_THREADS = 8,
+		MAX_SCALER_JOBS = NUM_DIRTY_RECT * MAX_SCALER_THREADS,
+		MIN_SCALER_BAND_HEIGHT = 16
+	};
+
+	// Scaler worker threads, set up through the "scaler_threads" config key
+	ScalerJob _scalerJobs[MAX_SCALER_JOBS];
+	int _queuedScalerJobs;
+
+	// Jobs handed to the worker threads, guarded by _scalerMutex
+	int _numScalerJobs;
+	int _nextScalerJob;
+	int _pendingScalerJobs;
+
+	int _numScalerThreads;
+	SDL_Thread *_scalerThreads[MAX_SCALER_THREADS];
+	SDL_mutex *_scalerMutex;
+	SDL_cond *_scalerWorkCond;
+	SDL_cond *_scalerDoneCond;
+	bool _scalerThreadsShouldQuit;
+
 	struct MousePos {
 		// The mouse position, using either virtual (game) or real
 		// (overlay) coordinates.
@@ -320,6 +358,24 @@ protected:
 
 	virtual void internUpdateScreen();
 
+	void initScalerThreads();
+	void deinitScalerThreads();
+
+	/**
+	 * Queue a part of the screen for scaling, split into bands if there
+	 * are scaler threads. Nothing is scaled before runScalerJobs(), and the
+	 * caller has to make sure the parts queued until then do not overlap.
+	 */
+	void queueScalerJob(ScalerProc *proc, const uint8 *src, uint32 srcPitch, uint8 *dst, uint32 dstPitch, int width, int height, int scale);
+
+	/**
+	 * Scale all queued jobs and wait for them to finish.
+	 */
+	void runScalerJobs();
+
+	void scalerThread();
+	static int SDLCALL scalerThreadEntry(void *arg);
+
 	virtual bool loadGFXMode();
 	virtual void unloadGFXMode();
 	virtual bool hotswapGFXMode();
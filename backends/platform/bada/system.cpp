@@ -81,6 +81,8 @@ struct BadaSaveFileManager : public DefaultSaveFileManager {
 };
 
 bool BadaSaveFileManager::removeSavefile(const Common::String &filename) {
+	savefileChanged();
+
 	Common::String savePathName = getSavePath();
 
 	checkPath(Common::FSNode(savePathName));
@@ -53,6 +53,8 @@ Common::OutSaveFile *GBAMPSaveFileManager::openForSaving(const Common::String &f
 
 //	consolePrintf("Opening the file: %s\n", fileSpec.c_str());
 
+	savefileChanged();
+
 	Common::WriteStream *stream = DS::DSFileStream::makeFromPath(fileSpec, true);
 	// Use a write buffer
 	stream = Common::wrapBufferedWriteStream(stream, SAVE_BUFFER_SIZE);
@@ -101,6 +101,7 @@ class FRAMSaveManager : public Common::SaveFileManager {
 public:
 
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) {
+		savefileChanged();
 		OutFRAMSave *s = new OutFRAMSave(filename.c_str());
 		if (!s->err()) {
 			return compress ? Common::wrapCompressedWriteStream(s) : s;
@@ -121,6 +122,7 @@ public:
 	}
 
 	virtual bool removeSavefile(const Common::String &filename) {
+		savefileChanged();
 		return ::fram_deleteSaveGame(filename.c_str());
 	}
 
@@ -150,6 +150,7 @@ Common::OutSaveFile *Ps2SaveFileManager::openForSaving(const Common::String &fil
 	Common::WriteStream *sf;
 
 	printf("openForSaving : %s\n", filename.c_str());
+	savefileChanged();
 
 	if (!savePath.exists() || !savePath.isDirectory())
 		return NULL;
@@ -200,6 +201,8 @@ bool Ps2SaveFileManager::removeSavefile(const Common::String &filename) {
 	Common::FSNode savePath(ConfMan.get("savepath")); // TODO: is this fast?
 	Common::FSNode file;
 
+	savefileChanged();
+
 	if (!savePath.exists() || !savePath.isDirectory())
 		return false;
 
@@ -31,19 +31,81 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
 #include "common/zlib.h"
 
 #ifndef _WIN32_WCE
 #include <errno.h>	// for removeSavefile()
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+enum {
+	/** Time spent compressing pending savefiles per event poll, in milliseconds. */
+	kSaveSliceTime = 2,
+
+	/** Minimum time between two slices, in milliseconds. */
+	kSaveSliceInterval = 10,
+
+	/** Amount of savefile data compressed at once. */
+	kSaveChunkSize = 8 * 1024
+};
+
+namespace {
+
+/**
+ * Collects a savefile in memory and hands it over to the savefile manager
+ * to be written in the background once it is finalized.
+ */
+class BackgroundOutSaveFile : public Common::OutSaveFile {
+public:
+	BackgroundOutSaveFile(DefaultSaveFileManager *manager, const Common::String &filename, bool compress)
+		: _manager(manager), _filename(filename), _compress(compress), _buffer(DisposeAfterUse::NO), _queued(false) {
+	}
+
+	~BackgroundOutSaveFile() {
+		finalize();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) {
+		if (_queued)
+			return 0;
+		return _buffer.write(dataPtr, dataSize);
+	}
+
+	void finalize() {
+		if (_queued)
+			return;
+		_queued = true;
+		_manager->queueSave(_filename, _buffer.getData(), _buffer.size(), _compress);
+	}
+
+private:
+	DefaultSaveFileManager *_manager;
+	Common::String _filename;
+	bool _compress;
+	Common::MemoryWriteStreamDynamic _buffer;
+	bool _queued;
+};
+
+} // End of anonymous namespace
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _observerRegistered(false), _lastSliceTime(0) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _observerRegistered(false), _lastSliceTime(0) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	// Unregister the event observer
+	if (_observerRegistered && g_system->getEventManager())
+		g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
+
+	waitForPendingSaves();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -55,6 +117,8 @@ void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 }
 
 Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &pattern) {
+	waitForPendingSaves();
+
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
 	if (getError().getCode() != Common::kNoError)
@@ -78,6 +142,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	waitForPendingSaves();
+
 	// Ensure that the savepath is valid. If not, generate an appropriate error.
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
@@ -98,6 +164,9 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	waitForPendingSaves();
+	savefileChanged();
+
 	// Ensure that the savepath is valid. If not, generate an appropriate error.
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
@@ -115,7 +184,134 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	return compress ? Common::wrapCompressedWriteStream(sf) : sf;
 }
 
+Common::OutSaveFile *DefaultSaveFileManager::openForSavingInBackground(const Common::String &filename, bool compress) {
+	// Ensure that the savepath is valid. If not, generate an appropriate error.
+	Common::String savePathName = getSavePath();
+	checkPath(Common::FSNode(savePathName));
+	if (getError().getCode() != Common::kNoError)
+		return 0;
+
+	return new BackgroundOutSaveFile(this, filename, compress);
+}
+
+void DefaultSaveFileManager::queueSave(const Common::String &filename, byte *data, uint32 size, bool compress) {
+	savefileChanged();
+
+	Common::FSNode savePath(getSavePath());
+
+	PendingSave *save = new PendingSave();
+	save->filename = filename;
+	save->file = savePath.getChild(filename);
+	save->data = data;
+	save->size = size;
+	save->pos = 0;
+	save->compress = compress;
+	save->queueTime = g_system->getMillis();
+	save->buffer = 0;
+	save->stream = 0;
+
+	_pendingSaves.push_back(save);
+
+	debug(2, "Queued savefile '%s' (%d bytes) for writing", filename.c_str(), size);
+
+	// The savefiles are compressed a slice at a time whenever the engine
+	// polls for events, on the engine's own thread. Without an event
+	// manager they are written right away.
+	if (!_observerRegistered && g_system->getEventManager()) {
+		g_system->getEventManager()->getEventDispatcher()->registerObserver(this, 0, false, true);
+		_observerRegistered = true;
+	}
+
+	if (!_observerRegistered)
+		waitForPendingSaves();
+}
+
+void DefaultSaveFileManager::waitForPendingSaves() {
+	while (!_pendingSaves.empty())
+		processPendingSave();
+}
+
+bool DefaultSaveFileManager::notifyPoll() {
+	if (_pendingSaves.empty())
+		return false;
+
+	// Engines may poll many times per frame, so limit both the time spent
+	// per poll and how often a slice is done.
+	const uint32 start = g_system->getMillis();
+	if (start - _lastSliceTime < kSaveSliceInterval)
+		return false;
+
+	do {
+		processPendingSave();
+	} while (!_pendingSaves.empty() && g_system->getMillis() - start < kSaveSliceTime);
+
+	_lastSliceTime = g_system->getMillis();
+	return false;
+}
+
+void DefaultSaveFileManager::processPendingSave() {
+	PendingSave *save = _pendingSaves.front();
+
+	if (save->compress) {
+		if (!save->stream) {
+			save->buffer = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+			save->stream = Common::wrapCompressedWriteStream(save->buffer);
+		}
+
+		const uint32 chunk = MIN<uint32>(save->size - save->pos, kSaveChunkSize);
+		save->stream->write(save->data + save->pos, chunk);
+		save->pos += chunk;
+
+		if (save->pos < save->size)
+			return;
+	}
+
+	_pendingSaves.pop_front();
+	finishPendingSave(save);
+}
+
+void DefaultSaveFileManager::finishPendingSave(PendingSave *save) {
+	const byte *data = save->data;
+	uint32 size = save->size;
+	bool success = true;
+
+	if (save->stream) {
+		save->stream->finalize();
+		success = !save->stream->err();
+		data = save->buffer->getData();
+		size = save->buffer->size();
+	}
+
+	// The savefile is only written once it is complete, and then replaces
+	// an old save of the same name as a whole. The old save stays intact
+	// while the new one is being compressed and written.
+	if (success) {
+		Common::WriteStream *sf = save->file.createAtomicWriteStream();
+		success = sf && sf->write(data, size) == size;
+		if (sf) {
+			sf->finalize();
+			success = success && !sf->err();
+		}
+		delete sf;
+	}
+
+	if (success)
+		debug(2, "Wrote savefile '%s' (%d bytes) %d ms after it was queued", save->filename.c_str(), save->size, g_system->getMillis() - save->queueTime);
+	else
+		warning("Failed to write savefile '%s'", save->filename.c_str());
+
+	// The compressing stream owns the buffer, but not its data
+	byte *compressed = save->buffer ? save->buffer->getData() : 0;
+	delete save->stream;
+	free(compressed);
+	free(save->data);
+	delete save;
+}
+
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	waitForPendingSaves();
+	savefileChanged();
+
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
 	if (getError().getCode() != Common::kNoError)
@@ -24,23 +24,43 @@
 #define BACKEND_SAVES_DEFAULT_H
 
 #include "common/scummsys.h"
+#include "common/events.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/fs.h"
+#include "common/list.h"
+
+namespace Common {
+class MemoryWriteStreamDynamic;
+}
 
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
-class DefaultSaveFileManager : public Common::SaveFileManager {
+class DefaultSaveFileManager : public Common::SaveFileManager, public Common::EventObserver {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	virtual ~DefaultSaveFileManager();
 
 	virtual Common::StringArray listSavefiles(const Common::String &pattern);
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
+	virtual Common::OutSaveFile *openForSavingInBackground(const Common::String &filename, bool compress = true);
+	virtual void waitForPendingSaves();
+	virtual bool hasPendingSaves() { return !_pendingSaves.empty(); }
 	virtual bool removeSavefile(const Common::String &filename);
 
+	/**
+	 * Queue the given savefile data to be written in the background.
+	 * Takes ownership of data, which must have been allocated with malloc().
+	 */
+	void queueSave(const Common::String &filename, byte *data, uint32 size, bool compress);
+
+	// Common::EventObserver API
+	virtual bool notifyEvent(const Common::Event &event) { return false; }
+	virtual bool notifyPoll();
+
 protected:
 	/**
 	 * Get the path to the savegame directory.
@@ -54,6 +74,33 @@ protected:
 	 * Sets the internal error and error message accordingly.
 	 */
 	virtual void checkPath(const Common::FSNode &dir);
+
+private:
+	struct PendingSave {
+		Common::String filename;
+		Common::FSNode file;
+		byte *data;
+		uint32 size;
+		uint32 pos;
+		bool compress;
+		uint32 queueTime;
+		Common::MemoryWriteStreamDynamic *buffer;
+		Common::WriteStream *stream;
+	};
+
+	typedef Common::List<PendingSave *> PendingSaveList;
+
+	/** Savefiles waiting to be written, oldest first. */
+	PendingSaveList _pendingSaves;
+	bool _observerRegistered;
+	uint32 _lastSliceTime;
+
+	/**
+	 * Compress the next chunk of the oldest pending savefile, and write
+	 * the savefile if it is complete.
+	 */
+	void processPendingSave();
+	void finishPendingSave(PendingSave *save);
 };
 
 #endif
@@ -21,6 +21,7 @@
 
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -34,47 +35,87 @@ struct TimerSlot {
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
 	TimerSlot *next;
+	TimerSlot **pprev;	// the pointer pointing to this slot, for O(1) removal
+
+	// Statistics, all times in milliseconds
+	uint32 fireCount;
+	uint32 totalLateness;
+	uint32 maxLateness;
+	uint32 totalDuration;
+	uint32 maxDuration;
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
-
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
-
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
-	}
+static void linkSlot(TimerSlot **list, TimerSlot *slot) {
+	slot->next = *list;
+	slot->pprev = list;
+	if (*list)
+		(*list)->pprev = &slot->next;
+	*list = slot;
+}
+
+static void unlinkSlot(TimerSlot *slot) {
+	*slot->pprev = slot->next;
+	if (slot->next)
+		slot->next->pprev = slot->pprev;
+	slot->next = 0;
+	slot->pprev = 0;
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
-	_head(0) {
+	_wheelTime(0), _due(0), _firing(false), _firingSlot(0) {
 
-	_head = new TimerSlot();
-	memset(_head, 0, sizeof(TimerSlot));
+	memset(_wheel0, 0, sizeof(_wheel0));
+	memset(_wheel, 0, sizeof(_wheel));
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (TimerSlotMap::iterator i = _callbacks.begin(); i != _callbacks.end(); ++i)
+		delete i->_value;
+	_callbacks.clear();
+}
+
+void DefaultTimerManager::addTimer(TimerSlot *slot) {
+	uint32 expires = slot->nextFireTime;
+	const int32 delta = (int32)(expires - _wheelTime);
+	TimerSlot **list;
+
+	if (delta <= 0) {
+		// Already due: when called from handler(), the timer has to fire
+		// again in the millisecond being processed.
+		list = _firing ? &_due : &_wheel0[_wheelTime & kWheelMask0];
+	} else if (delta < kWheelSize0) {
+		list = &_wheel0[expires & kWheelMask0];
+	} else if (delta < (1 << (kWheelBits0 + kWheelBits))) {
+		list = &_wheel[0][(expires >> kWheelBits0) & kWheelMask];
+	} else {
+		// Timers further away than the wheel reaches are put into its last
+		// bucket, and sorted in again when that bucket is cascaded.
+		if (delta >= (1 << (kWheelBits0 + 2 * kWheelBits)))
+			expires = _wheelTime + (1 << (kWheelBits0 + 2 * kWheelBits)) - 1;
+		list = &_wheel[1][(expires >> (kWheelBits0 + kWheelBits)) & kWheelMask];
+	}
+
+	linkSlot(list, slot);
+}
+
+void DefaultTimerManager::cascade(int level, uint index) {
+	// Move the slots to a temporary list first. This reverses their order,
+	// so that they end up in their new buckets in the order they were added.
+	TimerSlot *slots = 0;
+	while (_wheel[level][index]) {
+		TimerSlot *slot = _wheel[level][index];
+		unlinkSlot(slot);
+		linkSlot(&slots, slot);
+	}
+
+	while (slots) {
+		TimerSlot *slot = slots;
+		unlinkSlot(slot);
+		addTimer(slot);
 	}
-	_head = 0;
 }
 
 void DefaultTimerManager::handler() {
@@ -82,29 +123,67 @@ void DefaultTimerManager::handler() {
 
 	const uint32 curTime = g_system->getMillis();
 
-	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
-		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
+	if (_callbacks.empty()) {
+		_wheelTime = curTime;
+		return;
+	}
+
+	// Process every millisecond up to curTime - 1, so that a TimerSlot fires
+	// once its scheduled time has passed.
+	while ((int32)(curTime - _wheelTime) > 0) {
+		const uint index = _wheelTime & kWheelMask0;
+		if (index == 0) {
+			const uint index1 = (_wheelTime >> kWheelBits0) & kWheelMask;
+			if (index1 == 0)
+				cascade(1, (_wheelTime >> (kWheelBits0 + kWheelBits)) & kWheelMask);
+			cascade(0, index1);
 		}
-		insertPrioQueue(_head, slot);
 
-		// Invoke the timer callback
-		assert(slot->callback);
-		slot->callback(slot->refCon);
+		// Move the timers of this millisecond to the due list, oldest first
+		while (_wheel0[index]) {
+			TimerSlot *slot = _wheel0[index];
+			unlinkSlot(slot);
+			linkSlot(&_due, slot);
+		}
+
+		_firing = true;
+		while (_due) {
+			TimerSlot *slot = _due;
+			unlinkSlot(slot);
+
+			const uint32 lateness = curTime - slot->nextFireTime;
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+			// Update the fire time and reschedule the TimerSlot
+			assert(slot->interval > 0);
+			slot->nextFireTime += (slot->interval / 1000);
+			slot->nextFireTimeMicro += (slot->interval % 1000);
+			if (slot->nextFireTimeMicro > 1000) {
+				slot->nextFireTime += slot->nextFireTimeMicro / 1000;
+				slot->nextFireTimeMicro %= 1000;
+			}
+			addTimer(slot);
+
+			slot->fireCount++;
+			slot->totalLateness += lateness;
+			slot->maxLateness = MAX(slot->maxLateness, lateness);
+
+			// Invoke the timer callback. It may remove its own timer, which
+			// resets _firingSlot.
+			assert(slot->callback);
+			_firingSlot = slot;
+			const uint32 startTime = g_system->getMillis();
+			slot->callback(slot->refCon);
+			const uint32 duration = g_system->getMillis() - startTime;
+
+			if (_firingSlot) {
+				slot->totalDuration += duration;
+				slot->maxDuration = MAX(slot->maxDuration, duration);
+			}
+			_firingSlot = 0;
+		}
+		_firing = false;
+
+		_wheelTime++;
 	}
 }
 
@@ -113,29 +192,34 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	Common::StackLock lock(_mutex);
 
 	if (_callbacks.contains(id)) {
-		if (_callbacks[id] != callback) {
+		if (_callbacks[id]->callback != callback) {
 			error("Different callbacks are referred by same name (%s)", id.c_str());
 		}
 	}
 	TimerSlotMap::const_iterator i;
 
 	for (i = _callbacks.begin(); i != _callbacks.end(); ++i) {
-		if (i->_value == callback) {
+		if (i->_value->callback == callback) {
 			error("Same callback added twice (old name: %s, new name: %s)", i->_key.c_str(), id.c_str());
 		}
 	}
-	_callbacks[id] = callback;
 
-	TimerSlot *slot = new TimerSlot;
+	const uint32 curTime = g_system->getMillis();
+
+	// The wheel is not advanced while there are no timers
+	if (_callbacks.empty())
+		_wheelTime = curTime;
+
+	TimerSlot *slot = new TimerSlot();
 	slot->callback = callback;
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
+	slot->nextFireTime = curTime + interval / 1000;
 	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = 0;
 
-	insertPrioQueue(_head, slot);
+	_callbacks[id] = slot;
+	addTimer(slot);
 
 	return true;
 }
@@ -143,18 +227,6 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
-		}
-	}
-
 	// We need to remove all names referencing the timer proc here.
 	//
 	// Else we run into troubles, when the client code removes and readds timer
@@ -168,7 +240,26 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	// A good test case is running a SCUMM with ALSA output and then a KYRA
 	// game for example.
 	for (TimerSlotMap::iterator i = _callbacks.begin(), end = _callbacks.end(); i != end; ++i) {
-		if (i->_value == callback)
+		if (i->_value->callback == callback) {
+			TimerSlot *slot = i->_value;
+			printTimerStats(slot);
+
+			unlinkSlot(slot);
+			if (slot == _firingSlot)
+				_firingSlot = 0;
+			delete slot;
+
 			_callbacks.erase(i);
+		}
 	}
 }
+
+void DefaultTimerManager::printTimerStats(const TimerSlot *slot) const {
+	if (!slot->fireCount)
+		return;
+
+	debug(2, "Timer '%s' (every %d us): %d calls, lateness avg %d ms, max %d ms, duration avg %d ms, max %d ms",
+	      slot->id.c_str(), slot->interval, slot->fireCount,
+	      slot->totalLateness / slot->fireCount, slot->maxLateness,
+	      slot->totalDuration / slot->fireCount, slot->maxDuration);
+}
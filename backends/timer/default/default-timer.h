@@ -29,14 +29,48 @@
 
 struct TimerSlot;
 
+/**
+ * Timer manager keeping the timers in a hierarchical timing wheel: three
+ * levels of buckets covering the next 256 milliseconds in steps of 1 ms,
+ * the next 16 seconds in steps of 256 ms and the next 17 minutes in steps
+ * of 16 seconds. Timers in the upper levels are moved down ("cascaded")
+ * as their time comes closer, which makes installing and removing a timer
+ * O(1) regardless of how many timers there are.
+ */
 class DefaultTimerManager : public Common::TimerManager {
 private:
-	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
+	typedef Common::HashMap<Common::String, TimerSlot *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
+
+	enum {
+		kWheelBits0 = 8,
+		kWheelBits = 6,
+		kWheelSize0 = 1 << kWheelBits0,
+		kWheelSize = 1 << kWheelBits,
+		kWheelMask0 = kWheelSize0 - 1,
+		kWheelMask = kWheelSize - 1,
+		kWheelLevels = 3
+	};
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
 	TimerSlotMap _callbacks;
 
+	TimerSlot *_wheel0[kWheelSize0];
+	TimerSlot *_wheel[kWheelLevels - 1][kWheelSize];
+
+	/** The next millisecond to be processed by handler(). */
+	uint32 _wheelTime;
+
+	/** Timers which fire in the millisecond currently being processed. */
+	TimerSlot *_due;
+	bool _firing;
+
+	/** The timer whose callback is running, reset if the timer is removed. */
+	TimerSlot *_firingSlot;
+
+	void addTimer(TimerSlot *slot);
+	void cascade(int level, uint index);
+	void printTimerStats(const TimerSlot *slot) const;
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
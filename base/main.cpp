@@ -44,6 +44,7 @@
 #include "common/events.h"
 #include "common/EventRecorder.h"
 #include "common/fs.h"
+#include "common/savefile.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
@@ -225,6 +226,9 @@ static Common::Error runGame(const EnginePlugin *plugin, OSystem &system, const
 	// Run the engine
 	Common::Error result = engine->run();
 
+	// Make sure any saves still being written in the background hit the disk
+	system.getSavefileManager()->waitForPendingSaves();
+
 	// Inform backend that the engine finished
 	system.engineDone();
 
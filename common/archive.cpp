@@ -92,6 +92,43 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	invalidateIndex();
+}
+
+void SearchSet::invalidateIndex() {
+	_index.clear();
+	_indexValid = false;
+}
+
+void SearchSet::buildIndex() const {
+	_index.clear();
+
+	int pos = 0;
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for ( ; it != _list.end(); ++it, ++pos) {
+		if (!it->_dir)
+			continue;
+
+		StringArray names;
+		it->_dir->listMemberNames(names);
+
+		// Archives with a higher priority come first, so keep the first
+		// directory found for each name.
+		for (StringArray::const_iterator name = names.begin(); name != names.end(); ++name) {
+			if (!_index.contains(*name))
+				_index[*name] = pos;
+		}
+	}
+
+	_indexValid = true;
+}
+
+int SearchSet::lookupIndex(const String &name) const {
+	if (!_indexValid)
+		buildIndex();
+
+	FileIndex::const_iterator i = _index.find(name);
+	return i != _index.end() ? i->_value : -1;
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -115,7 +152,15 @@ void SearchSet::addDirectory(const String &name, const FSNode &dir, int priority
 	if (!dir.exists() || !dir.isDirectory())
 		return;
 
-	add(name, new FSDirectory(dir, depth, flat), priority);
+	if (find(name) != _list.end()) {
+		warning("SearchSet::addDirectory: archive '%s' already present", name.c_str());
+		return;
+	}
+
+	FSDirectory *fsDir = new FSDirectory(dir, depth, flat);
+	Node node(priority, name, fsDir, true);
+	node._dir = fsDir;
+	insert(node);
 }
 
 void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPattern, bool ignoreCase, int priority) {
@@ -174,6 +219,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateIndex();
 	}
 }
 
@@ -188,6 +234,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateIndex();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -206,14 +253,26 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
+/*
+	Indexed directories other than the one the index points at can be
+	skipped, as they don't have the file. Should that one not have it
+	anymore after all, all the remaining archives are checked.
+*/
 bool SearchSet::hasFile(const String &name) const {
 	if (name.empty())
 		return false;
 
+	const int candidate = lookupIndex(name);
+	bool useIndex = true;
+	int pos = 0;
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it) {
+	for ( ; it != _list.end(); ++it, ++pos) {
+		if (it->_dir && useIndex && pos != candidate)
+			continue;
 		if (it->_arc->hasFile(name))
 			return true;
+		if (pos == candidate)
+			useIndex = false;
 	}
 
 	return false;
@@ -243,10 +302,17 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
+	const int candidate = lookupIndex(name);
+	bool useIndex = true;
+	int pos = 0;
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it) {
+	for ( ; it != _list.end(); ++it, ++pos) {
+		if (it->_dir && useIndex && pos != candidate)
+			continue;
 		if (it->_arc->hasFile(name))
 			return it->_arc->getMember(name);
+		if (pos == candidate)
+			useIndex = false;
 	}
 
 	return ArchiveMemberPtr();
@@ -256,11 +322,18 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	if (name.empty())
 		return 0;
 
+	const int candidate = lookupIndex(name);
+	bool useIndex = true;
+	int pos = 0;
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it) {
+	for ( ; it != _list.end(); ++it, ++pos) {
+		if (it->_dir && useIndex && pos != candidate)
+			continue;
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
 		if (stream)
 			return stream;
+		if (pos == candidate)
+			useIndex = false;
 	}
 
 	return 0;
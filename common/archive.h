@@ -24,12 +24,15 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
 
 namespace Common {
 
+class FSDirectory;
 class FSNode;
 class SeekableReadStream;
 
@@ -133,13 +136,28 @@ class SearchSet : public Archive {
 		String	_name;
 		Archive	*_arc;
 		bool	_autoFree;
+		FSDirectory	*_dir;	// set for directories added with addDirectory(), which are indexed
 		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree), _dir(0) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
 	ArchiveNodeList _list;
 
+	// Maps the name of every file in the indexed directories to the position
+	// in _list of the first of them containing it. It is built on the first
+	// lookup and discarded whenever the list of archives changes.
+	typedef HashMap<String, int, IgnoreCase_Hash, IgnoreCase_EqualTo> FileIndex;
+	mutable FileIndex _index;
+	mutable bool _indexValid;
+
+	void invalidateIndex();
+	void buildIndex() const;
+
+	// Return the position of the indexed directory which should have the
+	// file, or -1 if none of them has it.
+	int lookupIndex(const String &name) const;
+
 	ArchiveNodeList::iterator find(const String &name);
 	ArchiveNodeList::const_iterator find(const String &name) const;
 
@@ -147,6 +165,7 @@ class SearchSet : public Archive {
 	void insert(const Node& node);
 
 public:
+	SearchSet() : _indexValid(false) {}
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -48,7 +48,7 @@ char const *const ConfigManager::kKeymapperDomain = "keymapper";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(0) {
+ConfigManager::ConfigManager() : _activeDomain(0), _flushedImageValid(false) {
 }
 
 void ConfigManager::defragment() {
@@ -71,6 +71,8 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	_flushedImage = source._flushedImage;
+	_flushedImageValid = source._flushedImageValid;
 }
 
 
@@ -79,6 +81,7 @@ void ConfigManager::loadDefaultConfigFile() {
 	assert(g_system);
 	SeekableReadStream *stream = g_system->createConfigReadStream();
 	_filename.clear();  // clear the filename to indicate that we are using the default config file
+	_flushedImageValid = false;
 
 	// ... load it, if available ...
 	if (stream) {
@@ -97,6 +100,7 @@ void ConfigManager::loadDefaultConfigFile() {
 
 void ConfigManager::loadConfigFile(const String &filename) {
 	_filename = filename;
+	_flushedImageValid = false;
 
 	FSNode node(filename);
 	File cfg_file;
@@ -164,38 +168,62 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	// TODO: Detect if a domain occurs multiple times (or likewise, if
 	// a key occurs multiple times inside one domain).
 
-	while (!stream.eos() && !stream.err()) {
+	// Read the whole file at once: splitting it into lines in memory is
+	// much faster than reading it through the stream line by line.
+	const int32 size = stream.size() - stream.pos();
+	if (size <= 0)
+		return;
+
+	char *buffer = (char *)malloc(size + 1);
+	assert(buffer);
+	const uint32 bytesRead = stream.read(buffer, size);
+	buffer[bytesRead] = 0;
+
+	const char *next = buffer;
+	const char *bufferEnd = buffer + bytesRead;
+
+	while (next < bufferEnd) {
 		lineno++;
 
-		// Read a line
-		String line = stream.readLine();
+		// Find the end of the line. Like SeekableReadStream::readLine(),
+		// accept LF, CR/LF and CR line breaks.
+		const char *line = next;
+		const char *lineEnd = line;
+		while (lineEnd < bufferEnd && *lineEnd != '\n' && *lineEnd != '\r')
+			lineEnd++;
+
+		next = lineEnd;
+		if (next < bufferEnd && *next == '\r')
+			next++;
+		if (next < bufferEnd && *next == '\n' && (next == lineEnd || next[-1] == '\r'))
+			next++;
 
-		if (line.size() == 0) {
+		if (line == lineEnd) {
 			// Do nothing
 		} else if (line[0] == '#') {
 			// Accumulate comments here. Once we encounter either the start
 			// of a new domain, or a key-value-pair, we associate the value
 			// of the 'comment' variable with that entity.
-			comment += line;
+			comment += String(line, lineEnd);
 			comment += "\n";
 		} else if (line[0] == '[') {
 			// It's a new domain which begins here.
 			// Determine where the previously accumulated domain goes, if we accumulated anything.
 			addDomain(domainName, domain);
 			domain.clear();
-			const char *p = line.c_str() + 1;
+			const char *p = line + 1;
 			// Get the domain name, and check whether it's valid (that
 			// is, verify that it only consists of alphanumerics,
 			// dashes and underscores).
-			while (*p && (isAlnum(*p) || *p == '-' || *p == '_'))
+			while (p < lineEnd && (isAlnum(*p) || *p == '-' || *p == '_'))
 				p++;
 
-			if (*p == '\0')
+			if (p == lineEnd || *p == '\0')
 				error("Config file buggy: missing ] in line %d", lineno);
 			else if (*p != ']')
 				error("Config file buggy: Invalid character '%c' occurred in section name in line %d", *p, lineno);
 
-			domainName = String(line.c_str() + 1, p);
+			domainName = String(line + 1, p);
 
 			domain.setDomainComment(comment);
 			comment.clear();
@@ -204,12 +232,12 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			// This line should be a line with a 'key=value' pair, or an empty one.
 
 			// Skip leading whitespaces
-			const char *t = line.c_str();
-			while (isSpace(*t))
+			const char *t = line;
+			while (t < lineEnd && isSpace(*t))
 				t++;
 
 			// Skip empty lines / lines with only whitespace
-			if (*t == 0)
+			if (t == lineEnd)
 				continue;
 
 			// If no domain has been set, this config file is invalid!
@@ -218,20 +246,25 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			}
 
 			// Split string at '=' into 'key' and 'value'. First, find the "=" delimeter.
-			const char *p = strchr(t, '=');
+			const char *p = (const char *)memchr(t, '=', lineEnd - t);
 			if (!p)
-				error("Config file buggy: Junk found in line line %d: '%s'", lineno, t);
+				error("Config file buggy: Junk found in line line %d: '%s'", lineno, String(t, lineEnd).c_str());
 
-			// Extract the key/value pair
-			String key(t, p);
-			String value(p + 1);
+			// Extract the key/value pair, trimming off spaces
+			const char *keyEnd = p;
+			while (keyEnd > t && isSpace(keyEnd[-1]))
+				keyEnd--;
+			const char *value = p + 1;
+			while (value < lineEnd && isSpace(*value))
+				value++;
+			const char *valueEnd = lineEnd;
+			while (valueEnd > value && isSpace(valueEnd[-1]))
+				valueEnd--;
 
-			// Trim of spaces
-			key.trim();
-			value.trim();
+			String key(t, keyEnd);
 
 			// Finally, store the key/value pair in the active domain
-			domain[key] = value;
+			domain.setVal(key, String(value, valueEnd));
 
 			// Store comment
 			domain.setKVComment(key, comment);
@@ -239,45 +272,30 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 		}
 	}
 
+	free(buffer);
+
 	addDomain(domainName, domain); // Add the last domain found
 }
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	// Serialize everything into memory first, so that the file is written
+	// in one go and unchanged configurations don't have to be written at all.
+	String image;
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(image, kApplicationDomain, _appDomain);
 
 #ifdef ENABLE_KEYMAPPER
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(image, kKeymapperDomain, _keymapperDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(image, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
@@ -285,23 +303,63 @@ void ConfigManager::flushToDisk() {
 	// are not present anymore, so we validate each name.
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
-		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+		d = _gameDomains.find(*i);
+		if (d != _gameDomains.end()) {
+			writeDomain(image, d->_key, d->_value);
 		}
 	}
 
 	// Now write the domains which haven't been written yet
+	HashMap<String, bool, IgnoreCase_Hash, IgnoreCase_EqualTo> saved;
+	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i)
+		saved[*i] = true;
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
-		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+		if (!saved.contains(d->_key))
+			writeDomain(image, d->_key, d->_value);
 	}
 
+	if (_flushedImageValid && image == _flushedImage) {
+		debug(9, "ConfigManager: Configuration unchanged, not writing it");
+		return;
+	}
+
+	// The config file is written to a temporary file which then replaces
+	// it, so that it survives a crash while it is being written
+	WriteStream *stream;
+	if (_filename.empty()) {
+		// Write to the default config file
+		assert(g_system);
+		stream = g_system->createConfigWriteStream();
+		if (!stream)    // If writing to the config file is not possible, do nothing
+			return;
+	} else {
+		stream = FSNode(_filename).createAtomicWriteStream();
+		if (!stream) {
+			warning("Unable to write configuration file: %s", _filename.c_str());
+			return;
+		}
+	}
+
+	stream->write(image.c_str(), image.size());
+	stream->finalize();
+	const bool success = !stream->err();
 	delete stream;
 
+	if (!success) {
+		if (_filename.empty())
+			warning("Unable to write the default configuration file");
+		else
+			warning("Unable to write configuration file: %s", _filename.c_str());
+		return;
+	}
+
+	// Strings are reference counted, so this does not copy the image
+	_flushedImage = image;
+	_flushedImageValid = true;
 #endif // !__DC__
 }
 
-void ConfigManager::writeDomain(WriteStream &stream, const String &name, const Domain &domain) {
+void ConfigManager::writeDomain(String &out, const String &name, const Domain &domain) {
 	if (domain.empty())
 		return;     // Don't bother writing empty domains.
 
@@ -311,36 +369,30 @@ void ConfigManager::writeDomain(WriteStream &stream, const String &name, const D
 	if (domain.contains("id_came_from_command_line"))
 		return;
 
-	String comment;
-
 	// Write domain comment (if any)
-	comment = domain.getDomainComment();
-	if (!comment.empty())
-		stream.writeString(comment);
+	out += domain.getDomainComment();
 
 	// Write domain start
-	stream.writeByte('[');
-	stream.writeString(name);
-	stream.writeByte(']');
-	stream.writeByte('\n');
+	out += '[';
+	out += name;
+	out += "]\n";
 
 	// Write all key/value pairs in this domain, including comments
 	Domain::const_iterator x;
 	for (x = domain.begin(); x != domain.end(); ++x) {
 		if (!x->_value.empty()) {
 			// Write comment (if any)
-			if (domain.hasKVComment(x->_key)) {
-				comment = domain.getKVComment(x->_key);
-				stream.writeString(comment);
-			}
+			if (domain.hasKVComment(x->_key))
+				out += domain.getKVComment(x->_key);
+
 			// Write the key/value pair
-			stream.writeString(x->_key);
-			stream.writeByte('=');
-			stream.writeString(x->_value);
-			stream.writeByte('\n');
+			out += x->_key;
+			out += '=';
+			out += x->_value;
+			out += '\n';
 		}
 	}
-	stream.writeByte('\n');
+	out += '\n';
 }
 
 
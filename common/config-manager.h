@@ -126,6 +126,9 @@ public:
 
 	void				flushToDisk();
 
+	/** The config file passed to loadConfigFile(), empty for the default one */
+	const String &		getConfigFileName() const { return _filename; }
+
 	void				setActiveDomain(const String &domName);
 	Domain *			getActiveDomain() { return _activeDomain; }
 	const Domain *		getActiveDomain() const { return _activeDomain; }
@@ -154,7 +157,7 @@ private:
 
 	void			loadFromStream(SeekableReadStream &stream);
 	void			addDomain(const String &domainName, const Domain &domain);
-	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
+	void			writeDomain(String &out, const String &name, const Domain &domain);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
 
 	Domain			_transientDomain;
@@ -173,6 +176,13 @@ private:
 	Domain *		_activeDomain;
 
 	String			_filename;
+
+	/**
+	 * The configuration as last written by flushToDisk(). Flushing an
+	 * unchanged configuration does not touch the file.
+	 */
+	String			_flushedImage;
+	bool			_flushedImageValid;
 };
 
 } // End of namespace Common
@@ -71,6 +71,90 @@ static void displayCoroStats() {
 } // End of anonymous namespace
 #endif
 
+namespace {
+
+enum {
+	/** Granularity of the context size classes */
+	kCoroSizeGranularity = 16,
+	/** Contexts larger than this come straight from the heap */
+	kCoroMaxPooledSize = 512,
+	kCoroNumSizeClasses = kCoroMaxPooledSize / kCoroSizeGranularity,
+	/** Maximum number of free contexts kept around per size class */
+	kCoroMaxFreePerClass = 64
+};
+
+struct CoroFreeBlock {
+	CoroFreeBlock *next;
+};
+
+static CoroFreeBlock *s_freeBlocks[kCoroNumSizeClasses];
+static uint s_numFreeBlocks[kCoroNumSizeClasses];
+
+// context allocation counters
+static uint32 s_ctxAllocs = 0;
+static uint32 s_ctxPoolHits = 0;
+static uint32 s_ctxLive = 0;
+
+/**
+ * Releases all the cached free contexts back to the heap
+ */
+static void purgeContextPool() {
+	for (int i = 0; i < kCoroNumSizeClasses; ++i) {
+		while (s_freeBlocks[i]) {
+			CoroFreeBlock *block = s_freeBlocks[i];
+			s_freeBlocks[i] = block->next;
+			free(block);
+		}
+		s_numFreeBlocks[i] = 0;
+	}
+}
+
+} // End of anonymous namespace
+
+void *CoroBaseContext::operator new(size_t size) {
+	++s_ctxAllocs;
+	++s_ctxLive;
+
+	if (size > 0 && size <= kCoroMaxPooledSize) {
+		const uint sizeClass = (size - 1) / kCoroSizeGranularity;
+		CoroFreeBlock *block = s_freeBlocks[sizeClass];
+		if (block) {
+			s_freeBlocks[sizeClass] = block->next;
+			--s_numFreeBlocks[sizeClass];
+			++s_ctxPoolHits;
+			return block;
+		}
+
+		size = (sizeClass + 1) * kCoroSizeGranularity;
+	}
+
+	void *ptr = malloc(size);
+	if (!ptr)
+		error("Cannot allocate memory for coroutine context");
+	return ptr;
+}
+
+void CoroBaseContext::operator delete(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	--s_ctxLive;
+
+	// The destructor is virtual, so size is always that of the actual context
+	if (size > 0 && size <= kCoroMaxPooledSize) {
+		const uint sizeClass = (size - 1) / kCoroSizeGranularity;
+		if (s_numFreeBlocks[sizeClass] < kCoroMaxFreePerClass) {
+			CoroFreeBlock *block = (CoroFreeBlock *)ptr;
+			block->next = s_freeBlocks[sizeClass];
+			s_freeBlocks[sizeClass] = block;
+			++s_numFreeBlocks[sizeClass];
+			return;
+		}
+	}
+
+	free(ptr);
+}
+
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(0) {
 #ifdef COROUTINE_DEBUG
@@ -107,6 +191,11 @@ CoroutineScheduler::CoroutineScheduler() {
 	pRCfunction = NULL;
 	pidCounter = 0;
 
+	_statTicks = 0;
+	_statDispatches = 0;
+	_statWakeups = 0;
+	_statMillis = 0;
+
 	active = new PROCESS;
 	active->pPrevious = NULL;
 	active->pNext = NULL;
@@ -130,9 +219,10 @@ CoroutineScheduler::~CoroutineScheduler() {
 	active = 0;
 
 	// Clear the event list
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i)
-		delete *i;
+	for (EventMap::iterator i = _events.begin(); i != _events.end(); ++i)
+		delete i->_value;
+
+	purgeContextPool();
 }
 
 void CoroutineScheduler::reset() {
@@ -160,9 +250,13 @@ void CoroutineScheduler::reset() {
 		delete pProc->state;
 		pProc->state = 0;
 		Common::fill(&pProc->pidWaiting[0], &pProc->pidWaiting[CORO_MAX_PID_WAITING], 0);
+		pProc->blocked = false;
 		pProc = pProc->pNext;
 	}
 
+	_processPids.clear();
+	_waitQueues.clear();
+
 	// no active processes
 	pCurrent = active->pNext = NULL;
 
@@ -177,12 +271,20 @@ void CoroutineScheduler::reset() {
 }
 
 
-#ifdef DEBUG
 void CoroutineScheduler::printStats() {
+#ifdef DEBUG
 	debug("%i process of %i used", maxProcs, CORO_NUM_PROCESS);
-}
 #endif
 
+	if (_statTicks) {
+		debug("%u ticks: %.2f dispatches, %.3f ms and %.2f context allocations per tick, %u wakeups",
+		      _statTicks, (double)_statDispatches / _statTicks, (double)_statMillis / _statTicks,
+		      (double)s_ctxAllocs / _statTicks, _statWakeups);
+	}
+	debug("%u contexts allocated, %u of them from the pool, %u live",
+	      s_ctxAllocs, s_ctxPoolHits, s_ctxLive);
+}
+
 #ifdef DEBUG
 void CoroutineScheduler::checkStack() {
 	Common::List<PROCESS *> pList;
@@ -219,6 +321,8 @@ void CoroutineScheduler::checkStack() {
 #endif
 
 void CoroutineScheduler::schedule() {
+	const uint32 startTime = g_system->getMillis();
+
 	// start dispatching active process list
 	PROCESS *pNext;
 	PROCESS *pProc = active->pNext;
@@ -227,6 +331,7 @@ void CoroutineScheduler::schedule() {
 
 		if (--pProc->sleepTime <= 0) {
 			// process is ready for dispatch, activate it
+			++_statDispatches;
 			pCurrent = pProc;
 			pProc->coroAddr(pProc->state, pProc->param);
 
@@ -247,13 +352,16 @@ void CoroutineScheduler::schedule() {
 	}
 
 	// Disable any events that were pulsed
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pulsing) {
+	for (uint i = 0; i < _pulsedEvents.size(); ++i) {
+		EVENT *evt = getEvent(_pulsedEvents[i]);
+		if (evt && evt->pulsing) {
 			evt->pulsing = evt->signalled = false;
 		}
 	}
+	_pulsedEvents.clear();
+
+	++_statTicks;
+	_statMillis += g_system->getMillis() - startTime;
 }
 
 void CoroutineScheduler::rescheduleAll() {
@@ -347,7 +455,7 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 
 	CORO_BEGIN_CONTEXT;
 		uint32 endTime;
-		PROCESS *pProcess;
+		bool processFound;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -363,13 +471,15 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() <= _ctx->endTime) {
+		unblock(pCurrent);
+
 		// Check to see if a process or event with the given Id exists
-		_ctx->pProcess = getProcess(pid);
-		_ctx->pEvent = !_ctx->pProcess ? getEvent(pid) : NULL;
+		_ctx->processFound = processExists(pid);
+		_ctx->pEvent = !_ctx->processFound ? getEvent(pid) : NULL;
 
 		// If there's no active process or event, presume it's a process that's finished,
 		// so the waiting can immediately exit
-		if ((_ctx->pProcess == NULL) && (_ctx->pEvent == NULL)) {
+		if (!_ctx->processFound && (_ctx->pEvent == NULL)) {
 			if (expired)
 				*expired = false;
 			break;
@@ -387,8 +497,15 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 			break;
 		}
 
-		// Sleep until the next cycle
-		CORO_SLEEP(1);
+		// Without a time limit there's nothing to check until the process
+		// or event changes, so sleep until then. Otherwise sleep until the
+		// next cycle
+		if (duration == CORO_INFINITE) {
+			blockCurrent(1);
+			CORO_SLEEP(CORO_BLOCKED_SLEEP);
+		} else {
+			CORO_SLEEP(1);
+		}
 	}
 
 	// Signal waiting is done
@@ -407,7 +524,7 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		bool signalled;
 		bool pidSignalled;
 		int i;
-		PROCESS *pProcess;
+		bool processFound;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -424,14 +541,15 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() <= _ctx->endTime) {
+		unblock(pCurrent);
 		_ctx->signalled = bWaitAll;
 
 		for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
-			_ctx->pProcess = getProcess(pidList[_ctx->i]);
-			_ctx->pEvent = !_ctx->pProcess ? getEvent(pidList[_ctx->i]) : NULL;
+			_ctx->processFound = processExists(pidList[_ctx->i]);
+			_ctx->pEvent = !_ctx->processFound ? getEvent(pidList[_ctx->i]) : NULL;
 
 			// Determine the signalled state
-			_ctx->pidSignalled = (_ctx->pProcess) || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
+			_ctx->pidSignalled = _ctx->processFound || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
 
 			if (bWaitAll && !_ctx->pidSignalled)
 				_ctx->signalled = false;
@@ -445,7 +563,7 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 			for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
 				_ctx->pEvent = getEvent(pidList[_ctx->i]);
 
-				if (!_ctx->pEvent->manualReset)
+				if (_ctx->pEvent && !_ctx->pEvent->manualReset)
 					_ctx->pEvent->signalled = false;
 			}
 
@@ -454,8 +572,14 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 			break;
 		}
 
-		// Sleep until the next cycle
-		CORO_SLEEP(1);
+		// Sleep until one of the processes or events changes, or until the
+		// next cycle if there's a time limit to check
+		if (duration == CORO_INFINITE) {
+			blockCurrent(nCount);
+			CORO_SLEEP(CORO_BLOCKED_SLEEP);
+		} else {
+			CORO_SLEEP(1);
+		}
 	}
 
 	// Signal waiting is done
@@ -538,6 +662,10 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// set new process id
 	pProc->pid = pid;
+	addProcessPid(pid);
+
+	// not waiting on anything yet
+	pProc->blocked = false;
 
 	// set new process specific info
 	if (sizeParam) {
@@ -577,22 +705,32 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 	if (pRCfunction != NULL)
 		(pRCfunction)(pKillProc);
 
-	delete pKillProc->state;
-	pKillProc->state = 0;
+	freeProcess(pKillProc);
+}
+
+void CoroutineScheduler::freeProcess(PROCESS *pProc) {
+	delete pProc->state;
+	pProc->state = 0;
+
+	unblock(pProc);
 
 	// Take the process out of the active chain list
-	pKillProc->pPrevious->pNext = pKillProc->pNext;
-	if (pKillProc->pNext)
-		pKillProc->pNext->pPrevious = pKillProc->pPrevious;
+	pProc->pPrevious->pNext = pProc->pNext;
+	if (pProc->pNext)
+		pProc->pNext->pPrevious = pProc->pPrevious;
 
 	// link first free process after pProc
-	pKillProc->pNext = pFreeProcesses;
+	pProc->pNext = pFreeProcesses;
 	if (pFreeProcesses)
-		pKillProc->pNext->pPrevious = pKillProc;
-	pKillProc->pPrevious = NULL;
+		pProc->pNext->pPrevious = pProc;
+	pProc->pPrevious = NULL;
+
+	// make pProc the first free process
+	pFreeProcesses = pProc;
 
-	// make pKillProc the first free process
-	pFreeProcesses = pKillProc;
+	// Anything waiting on the process needs to check whether it's finished
+	removeProcessPid(pProc->pid);
+	wakeWaiters(pProc->pid);
 }
 
 PROCESS *CoroutineScheduler::getCurrentProcess() {
@@ -626,21 +764,7 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 				if (pRCfunction != NULL)
 					(pRCfunction)(pProc);
 
-				delete pProc->state;
-				pProc->state = 0;
-
-				// make prev point to next to unlink pProc
-				pPrev->pNext = pProc->pNext;
-				if (pProc->pNext)
-					pPrev->pNext->pPrevious = pPrev;
-
-				// link first free process after pProc
-				pProc->pNext = pFreeProcesses;
-				pProc->pPrevious = NULL;
-				pFreeProcesses->pPrevious = pProc;
-
-				// make pProc the first free process
-				pFreeProcesses = pProc;
+				freeProcess(pProc);
 
 				// set to a process on the active list
 				pProc = pPrev;
@@ -662,23 +786,75 @@ void CoroutineScheduler::setResourceCallback(VFPTRPP pFunc) {
 	pRCfunction = pFunc;
 }
 
-PROCESS *CoroutineScheduler::getProcess(uint32 pid) {
-	PROCESS *pProc = active->pNext;
-	while ((pProc != NULL) && (pProc->pid != pid))
-		pProc = pProc->pNext;
-
-	return pProc;
+bool CoroutineScheduler::processExists(uint32 pid) const {
+	return _processPids.contains(pid);
 }
 
 EVENT *CoroutineScheduler::getEvent(uint32 pid) {
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pid == pid)
-			return evt;
+	EventMap::iterator i = _events.find(pid);
+	return (i != _events.end()) ? i->_value : NULL;
+}
+
+void CoroutineScheduler::addProcessPid(uint32 pid) {
+	++_processPids[pid];
+}
+
+void CoroutineScheduler::removeProcessPid(uint32 pid) {
+	ProcessCountMap::iterator i = _processPids.find(pid);
+	assert(i != _processPids.end());
+
+	if (--i->_value == 0)
+		_processPids.erase(i);
+}
+
+void CoroutineScheduler::blockCurrent(int nCount) {
+	assert(pCurrent && !pCurrent->blocked);
+
+	for (int i = 0; i < nCount; ++i)
+		_waitQueues[pCurrent->pidWaiting[i]].push_back(pCurrent);
+
+	pCurrent->blocked = true;
+}
+
+void CoroutineScheduler::unblock(PROCESS *pProc) {
+	if (!pProc->blocked)
+		return;
+
+	pProc->blocked = false;
+
+	for (int i = 0; i < CORO_MAX_PID_WAITING; ++i) {
+		WaitQueueMap::iterator q = _waitQueues.find(pProc->pidWaiting[i]);
+		if (q == _waitQueues.end())
+			continue;
+
+		Common::Array<PROCESS *> &queue = q->_value;
+		for (uint j = 0; j < queue.size();) {
+			if (queue[j] == pProc)
+				queue.remove_at(j);
+			else
+				++j;
+		}
+
+		if (queue.empty())
+			_waitQueues.erase(q);
 	}
+}
+
+void CoroutineScheduler::wakeWaiters(uint32 pid) {
+	// Each waiter is removed from all its queues, so this queue shrinks
+	// with every pass until it's erased
+	for (;;) {
+		WaitQueueMap::iterator q = _waitQueues.find(pid);
+		if (q == _waitQueues.end())
+			break;
+
+		PROCESS *pProc = q->_value.back();
+		unblock(pProc);
 
-	return NULL;
+		// Run again on its next turn, as it would have when polling
+		pProc->sleepTime = 1;
+		++_statWakeups;
+	}
 }
 
 
@@ -689,22 +865,27 @@ uint32 CoroutineScheduler::createEvent(bool bManualReset, bool bInitialState) {
 	evt->signalled = bInitialState;
 	evt->pulsing = false;
 
-	_events.push_back(evt);
+	_events[evt->pid] = evt;
 	return evt->pid;
 }
 
 void CoroutineScheduler::closeEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
 	if (evt) {
-		_events.remove(evt);
+		_events.erase(pidEvent);
 		delete evt;
+
+		// Waiting on a closed event finishes immediately
+		wakeWaiters(pidEvent);
 	}
 }
 
 void CoroutineScheduler::setEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
-	if (evt)
+	if (evt) {
 		evt->signalled = true;
+		wakeWaiters(pidEvent);
+	}
 }
 
 void CoroutineScheduler::resetEvent(uint32 pidEvent) {
@@ -721,6 +902,8 @@ void CoroutineScheduler::pulseEvent(uint32 pidEvent) {
 	// Set the event as signalled and pulsing
 	evt->signalled = true;
 	evt->pulsing = true;
+	_pulsedEvents.push_back(pidEvent);
+	wakeWaiters(pidEvent);
 
 	// If there's an active process, and it's not the first in the queue, then reschedule all
 	// the other prcoesses in the queue to run again this frame
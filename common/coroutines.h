@@ -24,6 +24,8 @@
 
 #include "common/scummsys.h"
 #include "common/util.h"    // for SCUMMVM_CURRENT_FUNCTION
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/singleton.h"
 
@@ -65,6 +67,14 @@ struct CoroBaseContext {
 	 * Destructor for coroutine context
 	 */
 	virtual ~CoroBaseContext();
+
+	/**
+	 * Contexts are created and destroyed on nearly every coroutine call,
+	 * so they are served from per size class free lists rather than the
+	 * general heap.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
 };
 
 typedef CoroBaseContext *CoroContext;
@@ -292,6 +302,9 @@ public:
 #define CORO_INFINITE 0xffffffff
 #define CORO_INVALID_PID_VALUE 0
 
+// the sleep value used by processes blocked on a wait queue
+#define CORO_BLOCKED_SLEEP 0x7fffffff
+
 /** Coroutine parameter for methods converted to coroutines */
 typedef void (*CORO_ADDR)(CoroContext &, const void *);
 
@@ -306,6 +319,7 @@ struct PROCESS {
 	int sleepTime;      ///< number of scheduler cycles to sleep
 	uint32 pid;         ///< process ID
 	uint32 pidWaiting[CORO_MAX_PID_WAITING];    ///< Process ID(s) process is currently waiting on
+	bool blocked;       ///< whether the process is asleep on the wait queues of pidWaiting
 	char param[CORO_PARAM_SIZE];    ///< process specific info
 };
 typedef PROCESS *PPROCESS;
@@ -357,8 +371,27 @@ private:
 	/** Auto-incrementing process Id */
 	int pidCounter;
 
-	/** Event list */
-	Common::List<EVENT *> _events;
+	typedef Common::HashMap<uint32, EVENT *> EventMap;
+	typedef Common::HashMap<uint32, uint> ProcessCountMap;
+	typedef Common::HashMap<uint32, Common::Array<PROCESS *> > WaitQueueMap;
+
+	/** Events, hashed by their Id */
+	EventMap _events;
+
+	/** Number of active processes using each process Id */
+	ProcessCountMap _processPids;
+
+	/** Processes blocked until the process or event with a given Id changes */
+	WaitQueueMap _waitQueues;
+
+	/** Events pulsed during the current tick */
+	Common::Array<uint32> _pulsedEvents;
+
+	// scheduler statistics
+	uint32 _statTicks;
+	uint32 _statDispatches;
+	uint32 _statWakeups;
+	uint32 _statMillis;
 
 #ifdef DEBUG
 	// diagnostic process counters
@@ -378,20 +411,43 @@ private:
 	 */
 	VFPTRPP pRCfunction;
 
-	PROCESS *getProcess(uint32 pid);
+	bool processExists(uint32 pid) const;
 	EVENT *getEvent(uint32 pid);
+
+	void addProcessPid(uint32 pid);
+	void removeProcessPid(uint32 pid);
+
+	/**
+	 * Blocks the current process until one of the first nCount Ids it is
+	 * waiting on is signalled, closed or finished.
+	 */
+	void blockCurrent(int nCount);
+
+	/**
+	 * Removes the process from the wait queues of all the Ids it is waiting on.
+	 */
+	void unblock(PROCESS *pProc);
+
+	/**
+	 * Makes all processes blocked on the given Id run again on their next turn.
+	 */
+	void wakeWaiters(uint32 pid);
+
+	/**
+	 * Unlinks a process from the active list and puts it on the free list.
+	 */
+	void freeProcess(PROCESS *pProc);
 public:
 	/**
 	 * Kills all processes and places them on the free list.
 	 */
 	void reset();
 
-#ifdef DEBUG
 	/**
-	 * Shows the maximum number of process used at once.
+	 * Shows the scheduler cost per tick, the context allocation rate and,
+	 * in debug builds, the maximum number of process used at once.
 	 */
 	void printStats();
-#endif
 
 	/**
 	 * Give all active processes a chance to run
@@ -151,6 +151,18 @@ WriteStream *FSNode::createWriteStream() const {
 	return _realNode->createWriteStream();
 }
 
+WriteStream *FSNode::createAtomicWriteStream() const {
+	if (_realNode == 0)
+		return 0;
+
+	if (_realNode->isDirectory()) {
+		warning("FSNode::createAtomicWriteStream: '%s' is a directory", getName().c_str());
+		return 0;
+	}
+
+	return _realNode->createAtomicWriteStream();
+}
+
 FSDirectory::FSDirectory(const FSNode &node, int depth, bool flat)
   : _node(node), _cached(false), _depth(depth), _flat(flat) {
 }
@@ -307,9 +319,26 @@ int FSDirectory::listMatchingMembers(ArchiveMemberList &list, const String &patt
 	String lowercasePattern(pattern);
 	lowercasePattern.toLowercase();
 
+	// Without any wildcards the pattern can only match the entry of the
+	// same name, so look it up directly.
+	const char *wildcard = strpbrk(lowercasePattern.c_str(), "*?");
+	if (!wildcard) {
+		NodeCache::const_iterator it = _fileCache.find(lowercasePattern);
+		if (it == _fileCache.end())
+			return 0;
+		list.push_back(ArchiveMemberPtr(new FSNode(it->_value)));
+		return 1;
+	}
+
+	// Everything up to the first wildcard has to match literally, which
+	// rules out most entries much quicker than matchString.
+	const uint prefixLen = wildcard - lowercasePattern.c_str();
+
 	int matches = 0;
 	NodeCache::const_iterator it = _fileCache.begin();
 	for ( ; it != _fileCache.end(); ++it) {
+		if (strncmp(it->_key.c_str(), lowercasePattern.c_str(), prefixLen))
+			continue;
 		if (it->_key.matchString(lowercasePattern, false, true)) {
 			list.push_back(ArchiveMemberPtr(new FSNode(it->_value)));
 			matches++;
@@ -334,5 +363,19 @@ int FSDirectory::listMembers(ArchiveMemberList &list) const {
 	return files;
 }
 
+int FSDirectory::listMemberNames(StringArray &names) const {
+	if (!_node.isDirectory())
+		return 0;
+
+	// Cache dir data
+	ensureCached();
+
+	NodeCache::const_iterator it = _fileCache.begin();
+	for ( ; it != _fileCache.end(); ++it)
+		names.push_back(it->_key);
+
+	return _fileCache.size();
+}
+
 
 } // End of namespace Common
@@ -28,6 +28,7 @@
 #include "common/hashmap.h"
 #include "common/ptr.h"
 #include "common/str.h"
+#include "common/str-array.h"
 
 class AbstractFSNode;
 
@@ -222,6 +223,18 @@ public:
 	 * @return pointer to the stream object, 0 in case of a failure
 	 */
 	WriteStream *createWriteStream() const;
+
+	/**
+	 * Creates a WriteStream instance which replaces the file referred by
+	 * this node as a whole. The data is written to a temporary file first,
+	 * which only replaces the file once the stream is finalized or deleted
+	 * without errors, so that the old file stays intact if writing fails.
+	 * Backends which cannot do this write to the file directly, just like
+	 * createWriteStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	WriteStream *createAtomicWriteStream() const;
 };
 
 /**
@@ -330,6 +343,12 @@ public:
 	 */
 	virtual int listMembers(ArchiveMemberList &list) const;
 
+	/**
+	 * Adds the names of all the files in the cache, in the form accepted by
+	 * hasFile(), to the given array.
+	 */
+	int listMemberNames(StringArray &names) const;
+
 	/**
 	 * Get a ArchiveMember representation of the specified file. A full match of relative
 	 * path and filename is needed for success.
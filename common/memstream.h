@@ -70,6 +70,79 @@ public:
 	int32 size() const { return _size; }
 
 	bool seek(int32 offs, int whence = SEEK_SET);
+
+	// Non-virtual versions of the ReadStream helpers, used instead of those
+	// whenever the caller knows it is dealing with a MemoryReadStream. Near
+	// the end of the data they fall back to the generic versions, so that
+	// the end of stream handling is the same.
+
+	byte readByte() {
+		if (_pos < _size) {
+			_pos++;
+			return *_ptr++;
+		}
+		return ReadStream::readByte();
+	}
+
+	int8 readSByte() {
+		return (int8)readByte();
+	}
+
+	uint16 readUint16LE() {
+		if (_size - _pos >= 2) {
+			const uint16 val = READ_LE_UINT16(_ptr);
+			_ptr += 2;
+			_pos += 2;
+			return val;
+		}
+		return ReadStream::readUint16LE();
+	}
+
+	uint32 readUint32LE() {
+		if (_size - _pos >= 4) {
+			const uint32 val = READ_LE_UINT32(_ptr);
+			_ptr += 4;
+			_pos += 4;
+			return val;
+		}
+		return ReadStream::readUint32LE();
+	}
+
+	uint16 readUint16BE() {
+		if (_size - _pos >= 2) {
+			const uint16 val = READ_BE_UINT16(_ptr);
+			_ptr += 2;
+			_pos += 2;
+			return val;
+		}
+		return ReadStream::readUint16BE();
+	}
+
+	uint32 readUint32BE() {
+		if (_size - _pos >= 4) {
+			const uint32 val = READ_BE_UINT32(_ptr);
+			_ptr += 4;
+			_pos += 4;
+			return val;
+		}
+		return ReadStream::readUint32BE();
+	}
+
+	int16 readSint16LE() {
+		return (int16)readUint16LE();
+	}
+
+	int32 readSint32LE() {
+		return (int32)readUint32LE();
+	}
+
+	int16 readSint16BE() {
+		return (int16)readUint16BE();
+	}
+
+	int32 readSint32BE() {
+		return (int32)readUint32BE();
+	}
 };
 
 
@@ -81,6 +154,22 @@ class MemoryReadStreamEndian : public MemoryReadStream, public ReadStreamEndian
 public:
 	MemoryReadStreamEndian(const byte *buf, uint32 len, bool bigEndian)
 		: MemoryReadStream(buf, len), ReadStreamEndian(bigEndian) {}
+
+	uint16 readUint16() {
+		return isBE() ? readUint16BE() : readUint16LE();
+	}
+
+	uint32 readUint32() {
+		return isBE() ? readUint32BE() : readUint32LE();
+	}
+
+	int16 readSint16() {
+		return (int16)readUint16();
+	}
+
+	int32 readSint32() {
+		return (int32)readUint32();
+	}
 };
 
 /**
@@ -135,7 +224,9 @@ private:
 
 		byte *old_data = _data;
 
-		_capacity = new_len + 32;
+		// Grow geometrically, so writing a large stream in small pieces
+		// doesn't copy the data over and over
+		_capacity = (new_len + 32 > _capacity * 2) ? new_len + 32 : _capacity * 2;
 		_data = (byte *)malloc(_capacity);
 		_ptr = _data + _pos;
 
@@ -73,9 +73,28 @@ protected:
 	 */
 	virtual void setError(Error error, const String &errorDesc) { _error = error; _errorDesc = errorDesc; }
 
+	/**
+	 * Note that a savefile is about to be written or removed. Implementations
+	 * call this from openForSaving() and removeSavefile().
+	 */
+	void savefileChanged() { _changeCount++; }
+
+private:
+	uint32 _changeCount;
+
 public:
+	SaveFileManager() : _changeCount(0) {}
 	virtual ~SaveFileManager() {}
 
+	/**
+	 * Returns a number which changes whenever a savefile is opened for
+	 * saving or removed. This allows to find out whether information read
+	 * from savefiles earlier may be out of date.
+	 *
+	 * @return the number of changes to savefiles so far
+	 */
+	uint32 getChangeCount() const { return _changeCount; }
+
 	/**
 	 * Clears the last set error code and string.
 	 */
@@ -122,6 +141,42 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the savefile with the specified name for saving in the background.
+	 *
+	 * The returned stream only collects the data in memory. Once it is
+	 * finalized (or deleted), the data is handed over to the savefile
+	 * manager, which compresses it a little at a time while the engine keeps
+	 * running, and writes the file once it is complete. This is meant for
+	 * engines whose saves are large enough to cause a noticeable hitch.
+	 *
+	 * Since the file is written later, errors while writing it can't be
+	 * reported through the returned stream. Opening, listing or removing
+	 * savefiles waits until all pending saves have been written.
+	 *
+	 * The default implementation simply calls openForSaving().
+	 *
+	 * @param name		the name of the savefile
+	 * @param compress	toggles whether to compress the resulting save file
+	 * 					(default) or not.
+	 * @return pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	virtual OutSaveFile *openForSavingInBackground(const String &name, bool compress = true) {
+		return openForSaving(name, compress);
+	}
+
+	/**
+	 * Block until all savefiles opened with openForSavingInBackground()
+	 * have been written.
+	 */
+	virtual void waitForPendingSaves() {}
+
+	/**
+	 * Check whether any savefiles opened with openForSavingInBackground()
+	 * have not been written yet.
+	 */
+	virtual bool hasPendingSaves() { return false; }
+
 	/**
 	 * Open the file with the specified name in the given directory for loading.
 	 * @param name	the name of the savefile
@@ -26,8 +26,60 @@
 #include "common/substream.h"
 #include "common/str.h"
 
+// SSE2 is always available on x86-64 and NEON on ARM64, so the bulk endian
+// readers use them to swap the bytes whenever the compiler targets them.
+#if defined(__SSE2__)
+#define USE_SSE2_SWAP
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define USE_NEON_SWAP
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 
+namespace {
+
+void swapBytes16(uint16 *data, uint32 count) {
+	uint32 i = 0;
+#if defined(USE_SSE2_SWAP)
+	for (; i + 8 <= count; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *)(data + i), v);
+	}
+#elif defined(USE_NEON_SWAP)
+	for (; i + 8 <= count; i += 8) {
+		uint8x16_t v = vld1q_u8((const uint8 *)(data + i));
+		vst1q_u8((uint8 *)(data + i), vrev16q_u8(v));
+	}
+#endif
+	for (; i < count; i++)
+		data[i] = SWAP_BYTES_16(data[i]);
+}
+
+void swapBytes32(uint32 *data, uint32 count) {
+	uint32 i = 0;
+#if defined(USE_SSE2_SWAP)
+	for (; i + 4 <= count; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+		// Swap the 16-bit halves of each word, then the bytes of each half
+		v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *)(data + i), v);
+	}
+#elif defined(USE_NEON_SWAP)
+	for (; i + 4 <= count; i += 4) {
+		uint8x16_t v = vld1q_u8((const uint8 *)(data + i));
+		vst1q_u8((uint8 *)(data + i), vrev32q_u8(v));
+	}
+#endif
+	for (; i < count; i++)
+		data[i] = SWAP_BYTES_32(data[i]);
+}
+
+} // End of anonymous namespace
+
 void WriteStream::writeString(const String &str) {
 	write(str.c_str(), str.size());
 }
@@ -40,6 +92,39 @@ SeekableReadStream *ReadStream::readStream(uint32 dataSize) {
 }
 
 
+uint32 ReadStream::readUint16LEArray(uint16 *dst, uint32 count) {
+	count = read(dst, count * 2) / 2;
+#ifdef SCUMM_BIG_ENDIAN
+	swapBytes16(dst, count);
+#endif
+	return count;
+}
+
+uint32 ReadStream::readUint32LEArray(uint32 *dst, uint32 count) {
+	count = read(dst, count * 4) / 4;
+#ifdef SCUMM_BIG_ENDIAN
+	swapBytes32(dst, count);
+#endif
+	return count;
+}
+
+uint32 ReadStream::readUint16BEArray(uint16 *dst, uint32 count) {
+	count = read(dst, count * 2) / 2;
+#ifdef SCUMM_LITTLE_ENDIAN
+	swapBytes16(dst, count);
+#endif
+	return count;
+}
+
+uint32 ReadStream::readUint32BEArray(uint32 *dst, uint32 count) {
+	count = read(dst, count * 4) / 4;
+#ifdef SCUMM_LITTLE_ENDIAN
+	swapBytes32(dst, count);
+#endif
+	return count;
+}
+
+
 uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Read at most as many bytes as are still available...
 	if (dataSize > _size - _pos) {
@@ -311,6 +311,37 @@ public:
 		return (int32)readUint32BE();
 	}
 
+	/**
+	 * Read count unsigned 16-bit words stored in little endian (LSB first)
+	 * order from the stream into dst. The data is fetched with a single
+	 * call to read(), which is a lot faster than reading the words one by
+	 * one, especially through several layers of streams.
+	 *
+	 * @return the number of words which were read completely.
+	 */
+	uint32 readUint16LEArray(uint16 *dst, uint32 count);
+
+	/**
+	 * Read count unsigned 32-bit words stored in little endian (LSB first)
+	 * order from the stream into dst.
+	 * @see readUint16LEArray
+	 */
+	uint32 readUint32LEArray(uint32 *dst, uint32 count);
+
+	/**
+	 * Read count unsigned 16-bit words stored in big endian (MSB first)
+	 * order from the stream into dst.
+	 * @see readUint16LEArray
+	 */
+	uint32 readUint16BEArray(uint16 *dst, uint32 count);
+
+	/**
+	 * Read count unsigned 32-bit words stored in big endian (MSB first)
+	 * order from the stream into dst.
+	 * @see readUint16LEArray
+	 */
+	uint32 readUint32BEArray(uint32 *dst, uint32 count);
+
 	/**
 	 * Read the specified amount of data into a malloc'ed buffer
 	 * which then is wrapped into a MemoryReadStream.
@@ -442,6 +473,14 @@ public:
 	FORCEINLINE int32 readSint32() {
 		return (int32)readUint32();
 	}
+
+	uint32 readUint16Array(uint16 *dst, uint32 count) {
+		return (_bigEndian) ? readUint16BEArray(dst, count) : readUint16LEArray(dst, count);
+	}
+
+	uint32 readUint32Array(uint32 *dst, uint32 count) {
+		return (_bigEndian) ? readUint32BEArray(dst, count) : readUint32LEArray(dst, count);
+	}
 };
 
 /**
@@ -25,6 +25,7 @@
 #include "common/fs.h"
 #include "common/memstream.h"
 #include "common/system.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -80,6 +81,12 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	// A compiled key stream has no source text to point at.
+	if (_compiledInput) {
+		g_system->logMessage(LogMessageType::kError, ("\n  File <" + _fileName + "> (compiled):\n\nParser error: " + errStr + "\n\n").c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -167,14 +174,14 @@ bool XMLParser::parseActiveKey(bool closed) {
 	if (layout->children.contains(key->name)) {
 		key->layout = layout->children[key->name];
 
-		StringMap localMap = key->values;
+		const StringMap &localMap = key->values;
 		int keyCount = localMap.size();
 
 		for (List<XMLKeyLayout::XMLKeyProperty>::const_iterator i = key->layout->properties.begin(); i != key->layout->properties.end(); ++i) {
-			if (i->required && !localMap.contains(i->name))
-				return parserError("Missing required property '" + i->name + "' inside key '" + key->name + "'");
-			else if (localMap.contains(i->name))
+			if (localMap.contains(i->name))
 				keyCount--;
+			else if (i->required)
+				return parserError("Missing required property '" + i->name + "' inside key '" + key->name + "'");
 		}
 
 		if (keyCount > 0)
@@ -385,6 +392,9 @@ bool XMLParser::parse() {
 
 		case kParserNeedPropertyName:
 			if (activeClosure) {
+				if (_compiledOutput)
+					_compiledOutput->writeByte(kCompiledKeyClose);
+
 				if (!closeKey()) {
 					parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
 					break;
@@ -411,7 +421,14 @@ bool XMLParser::parse() {
 			if (_char == '>') {
 				if (activeHeader && !selfClosure) {
 					parserError("XML Header must be self-closed.");
-				} else if (parseActiveKey(selfClosure)) {
+					activeHeader = false;
+					break;
+				}
+
+				if (_compiledOutput)
+					writeCompiledKey(selfClosure);
+
+				if (parseActiveKey(selfClosure)) {
 					_char = _stream->readByte();
 					_state = kParserNeedKey;
 				}
@@ -460,6 +477,105 @@ bool XMLParser::parse() {
 	return true;
 }
 
+static void writeCompiledString(WriteStream *stream, const String &str) {
+	stream->writeUint16LE(str.size());
+	stream->write(str.c_str(), str.size());
+}
+
+static String readCompiledString(SeekableReadStream *stream) {
+	uint16 size = stream->readUint16LE();
+	String str;
+	char buffer[256];
+
+	while (size > 0) {
+		const uint16 chunk = MIN<uint16>(size, sizeof(buffer));
+		if (stream->read(buffer, chunk) != chunk)
+			break;
+
+		str += String(buffer, chunk);
+		size -= chunk;
+	}
+
+	return str;
+}
+
+void XMLParser::writeCompiledKey(bool closed) {
+	const ParserNode *node = _activeKey.top();
+
+	_compiledOutput->writeByte(kCompiledKeyOpen);
+	_compiledOutput->writeByte((closed ? 1 : 0) | (node->header ? 2 : 0));
+	writeCompiledString(_compiledOutput, node->name);
+
+	_compiledOutput->writeUint16LE(node->values.size());
+	for (StringMap::const_iterator i = node->values.begin(); i != node->values.end(); ++i) {
+		writeCompiledString(_compiledOutput, i->_key);
+		writeCompiledString(_compiledOutput, i->_value);
+	}
+}
+
+bool XMLParser::parseCompiled() {
+	if (_stream == 0)
+		return parserError("XML stream not ready for reading.");
+
+	_stream->seek(0, SEEK_SET);
+
+	if (_XMLkeys == 0)
+		buildLayout();
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	cleanup();
+
+	_state = kParserNeedKey;
+	_compiledInput = true;
+
+	while (_state != kParserError) {
+		const byte record = _stream->readByte();
+		if (_stream->eos())
+			break;
+
+		if (record == kCompiledKeyOpen) {
+			const byte flags = _stream->readByte();
+
+			ParserNode *node = allocNode();
+			node->name = readCompiledString(_stream);
+			node->ignore = false;
+			node->header = (flags & 2) != 0;
+			node->depth = _activeKey.size();
+			node->layout = 0;
+
+			uint16 count = _stream->readUint16LE();
+			while (count--) {
+				const String name = readCompiledString(_stream);
+				node->values[name] = readCompiledString(_stream);
+			}
+
+			_activeKey.push(node);
+
+			if (!parseActiveKey((flags & 1) != 0) && _state != kParserError)
+				parserError("Unhandled exception when parsing '" + node->name + "' key.");
+		} else if (record == kCompiledKeyClose) {
+			if (_activeKey.empty()) {
+				parserError("Unexpected closure.");
+				break;
+			}
+
+			const String name = _activeKey.top()->name;
+			if (!closeKey())
+				parserError("Missing data when closing key '" + name + "'.");
+		} else {
+			parserError("Corrupted compiled key stream.");
+		}
+	}
+
+	if (_state != kParserError && !_activeKey.empty())
+		parserError("Unexpected end of file.");
+
+	_compiledInput = false;
+	return _state != kParserError;
+}
+
 bool XMLParser::skipSpaces() {
 	if (!isSpace(_char))
 		return false;
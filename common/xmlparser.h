@@ -37,6 +37,7 @@
 namespace Common {
 
 class SeekableReadStream;
+class WriteStream;
 
 #define MAX_XML_DEPTH 8
 
@@ -92,7 +93,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(0), _stream(0) {}
+	XMLParser() : _XMLkeys(0), _stream(0), _compiledOutput(0), _compiledInput(false) {}
 
 	virtual ~XMLParser();
 
@@ -187,6 +188,23 @@ public:
 	 */
 	bool parse();
 
+	/**
+	 * Parses the loaded data stream as a compiled key stream, as written
+	 * by parse() while a compiled output was set. The layout checks and
+	 * key callbacks run exactly as they would for the source XML, only
+	 * the tokenizing is skipped.
+	 */
+	bool parseCompiled();
+
+	/**
+	 * Sets a stream which the next calls to parse() record every opened
+	 * and closed key to, in the format read back by parseCompiled().
+	 * Pass 0 to stop recording. The parser does not take ownership.
+	 */
+	void setCompiledOutput(WriteStream *stream) {
+		_compiledOutput = stream;
+	}
+
 	/**
 	 * Returns the active node being parsed (the one on top of
 	 * the node stack).
@@ -327,6 +345,14 @@ protected:
 
 	bool parseXMLHeader(ParserNode *node);
 
+	/** Key records used by the compiled key stream. */
+	enum {
+		kCompiledKeyOpen = 'K',
+		kCompiledKeyClose = 'C'
+	};
+
+	void writeCompiledKey(bool closed);
+
 	/**
 	 * Overload if your parser needs to support parsing the same file
 	 * several times, so you can clean up the internal state of the
@@ -347,6 +373,9 @@ private:
 	String _token; /** Current text token */
 
 	Stack<ParserNode *> _activeKey; /** Node stack of the parsed keys */
+
+	WriteStream *_compiledOutput; /** Where parse() records keys to, if set */
+	bool _compiledInput; /** Set while parseCompiled() is running */
 };
 
 } // End of namespace Common
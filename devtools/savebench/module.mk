@@ -0,0 +1,16 @@
+MODULE := devtools/savebench
+
+MODULE_OBJS := \
+	savebench.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := savebench
+
+# The savefile manager and the filesystem code
+TOOL_DEPS := backends/libbackends.a common/libcommon.a
+
+# The savefiles are compressed with zlib, if it is available
+TOOL_LIBS := $(LIBS)
+
+# Include common rules
+include $(srcdir)/rules.mk
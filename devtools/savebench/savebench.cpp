@@ -0,0 +1,223 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a utility for timing the default savefile manager. A savefile of
+ * synthetic data is written once synchronously and once in the background,
+ * with events being polled like in a game loop until it has been written.
+ * The time the caller is blocked and the longest poll are printed for both.
+ *
+ * Usage: savebench <directory> [<size in KB>]
+ * The savefile is written to, and removed from, the given directory.
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "common/scummsys.h"
+#include "common/config-manager.h"
+#include "common/events.h"
+#include "common/random.h"
+#include "common/system.h"
+#include "common/util.h"
+#include "backends/fs/posix/posix-fs-factory.h"
+#include "backends/saves/default/default-saves.h"
+#include "graphics/pixelformat.h"
+
+/**
+ * Event manager without any events. Polling it only lets the observers,
+ * like the savefile manager, do their work.
+ */
+class BenchEventManager : public Common::EventManager {
+public:
+	BenchEventManager() {
+		_dispatcher.registerMapper(new Common::DefaultEventMapper());
+	}
+
+	bool pollEvent(Common::Event &event) {
+		_dispatcher.dispatch();
+		return false;
+	}
+
+	void pushEvent(const Common::Event &event) {}
+	Common::Point getMousePos() const { return Common::Point(); }
+	int getButtonState() const { return 0; }
+	int getModifierState() const { return 0; }
+	int shouldQuit() const { return 0; }
+	int shouldRTL() const { return 0; }
+	void resetRTL() {}
+#ifdef FORCE_RTL
+	void resetQuit() {}
+#endif
+#ifdef ENABLE_KEYMAPPER
+	Common::Keymapper *getKeymapper() { return 0; }
+#endif
+};
+
+/**
+ * The bare minimum of a backend needed by the savefile manager. The
+ * modular backend is not used, since it pulls in the GUI.
+ */
+class BenchSystem : public OSystem {
+public:
+	BenchSystem() {
+		gettimeofday(&_start, 0);
+		_fsFactory = new POSIXFilesystemFactory();
+	}
+
+	void initBackend() {
+		_eventManager = new BenchEventManager();
+		_savefileManager = new DefaultSaveFileManager();
+	}
+
+	uint32 getMillis() {
+		timeval now;
+		gettimeofday(&now, 0);
+		return (now.tv_sec - _start.tv_sec) * 1000 + (now.tv_usec - _start.tv_usec) / 1000;
+	}
+
+	void delayMillis(uint msecs) { usleep(msecs * 1000); }
+	void getTimeAndDate(TimeDate &t) const {}
+
+	MutexRef createMutex() { return 0; }
+	void lockMutex(MutexRef mutex) {}
+	void unlockMutex(MutexRef mutex) {}
+	void deleteMutex(MutexRef mutex) {}
+
+	void logMessage(LogMessageType::Type type, const char *message) { fputs(message, stderr); }
+
+	// There is no screen, no input and no sound
+	const GraphicsMode *getSupportedGraphicsModes() const { return 0; }
+	int getDefaultGraphicsMode() const { return 0; }
+	bool setGraphicsMode(int mode) { return false; }
+	int getGraphicsMode() const { return 0; }
+	Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	int16 getHeight() { return 0; }
+	int16 getWidth() { return 0; }
+	PaletteManager *getPaletteManager() { return 0; }
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	Graphics::Surface *lockScreen() { return 0; }
+	void unlockScreen() {}
+	void fillScreen(uint32 col) {}
+	void updateScreen() {}
+	void setShakePos(int shakeOffset) {}
+	void showOverlay() {}
+	void hideOverlay() {}
+	Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	void clearOverlay() {}
+	void grabOverlay(void *buf, int pitch) {}
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+	int16 getOverlayHeight() { return 0; }
+	int16 getOverlayWidth() { return 0; }
+	bool showMouse(bool visible) { return false; }
+	void warpMouse(int x, int y) {}
+	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+	Audio::Mixer *getMixer() { return 0; }
+	void quit() { exit(0); }
+	void displayMessageOnOSD(const char *msg) {}
+
+private:
+	timeval _start;
+};
+
+int main(int argc, char *argv[]) {
+	if (argc < 2 || argc > 3) {
+		printf("Usage: %s <directory> [<size in KB>]\n", argv[0]);
+		return 1;
+	}
+
+	uint32 size = 8 * 1024 * 1024;
+	if (argc > 2)
+		size = atoi(argv[2]) * 1024;
+
+	if (!size) {
+		printf("Invalid size '%s'\n", argv[2]);
+		return 1;
+	}
+
+	BenchSystem *system = new BenchSystem();
+	g_system = system;
+	ConfMan.set("savepath", argv[1]);
+	system->initBackend();
+
+	// Data which compresses about as well as a typical savefile
+	byte *data = (byte *)malloc(size);
+	Common::RandomSource rnd("savebench");
+	for (uint32 i = 0; i < size; ++i)
+		data[i] = (i % 7) ? (byte)(i >> 5) : rnd.getRandomNumber(255);
+
+	Common::SaveFileManager *saveMan = g_system->getSavefileManager();
+	const char *filename = "savebench.tmp";
+	int result = 0;
+
+	for (int background = 0; background < 2; ++background) {
+		const uint32 start = g_system->getMillis();
+
+		Common::OutSaveFile *file = background ? saveMan->openForSavingInBackground(filename) : saveMan->openForSaving(filename);
+		if (!file) {
+			printf("Could not open '%s' in '%s' for saving\n", filename, argv[1]);
+			result = 1;
+			break;
+		}
+
+		file->write(data, size);
+		file->finalize();
+		delete file;
+
+		const uint32 blocked = g_system->getMillis() - start;
+
+		// Poll for events at about 100 frames per second, like a game loop,
+		// until the savefile has been written
+		uint32 longestPoll = 0, polls = 0;
+		while (saveMan->hasPendingSaves()) {
+			const uint32 pollStart = g_system->getMillis();
+			Common::Event event;
+			while (g_system->getEventManager()->pollEvent(event))
+				;
+			longestPoll = MAX(longestPoll, g_system->getMillis() - pollStart);
+			++polls;
+
+			g_system->delayMillis(10);
+		}
+
+		if (background)
+			printf("Background: blocked %d ms, longest poll %d ms, written after %d polls and %d ms\n", blocked, longestPoll, polls, g_system->getMillis() - start);
+		else
+			printf("Synchronous: blocked %d ms\n", blocked);
+	}
+
+	saveMan->removeSavefile(filename);
+	free(data);
+
+	delete system;
+	return result;
+}
@@ -0,0 +1,13 @@
+MODULE := devtools/scalerbench
+
+MODULE_OBJS := \
+	scalerbench.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := scalerbench
+
+# The scalers and the little of common they use
+TOOL_DEPS := graphics/libgraphics.a common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
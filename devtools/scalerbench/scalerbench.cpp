@@ -0,0 +1,212 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a utility for timing the graphics scalers on a set of test frames.
+ * Every scaler is run on 320x200 and 640x480 frames in the 555 and 565
+ * formats, and a checksum of its output is printed next to the time, so two
+ * builds can be compared for both speed and identical output.
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/scummsys.h"
+#include "common/str.h"
+#include "common/util.h"
+#include "graphics/scaler.h"
+
+struct Scaler {
+	const char *name;
+	ScalerProc *proc;
+	int scale;
+};
+
+static const Scaler scalers[] = {
+	{ "Normal1x", Normal1x, 1 },
+#ifdef USE_SCALERS
+	{ "Normal2x", Normal2x, 2 },
+	{ "Normal3x", Normal3x, 3 },
+	{ "2xSaI", _2xSaI, 2 },
+	{ "Super2xSaI", Super2xSaI, 2 },
+	{ "SuperEagle", SuperEagle, 2 },
+	{ "AdvMame2x", AdvMame2x, 2 },
+	{ "AdvMame3x", AdvMame3x, 3 },
+	{ "TV2x", TV2x, 2 },
+	{ "DotMatrix", DotMatrix, 2 },
+#ifdef USE_HQ_SCALERS
+	{ "HQ2x", HQ2x, 2 },
+	{ "HQ3x", HQ3x, 3 },
+#endif
+#endif
+	{ 0, 0, 0 }
+};
+
+enum FrameType {
+	kFrameFlat,
+	kFrameGradient,
+	kFrameNoise,
+	kFrameTypeCount
+};
+
+static const char *const frameNames[kFrameTypeCount] = {
+	"flat", "gradient", "noise"
+};
+
+// The scalers read up to two pixels around the area they scale
+static const int border = 2;
+
+static uint32 randomSeed;
+
+static uint16 nextRandom() {
+	randomSeed = randomSeed * 1103515245 + 12345;
+	return (uint16)(randomSeed >> 16);
+}
+
+/**
+ * Fill a frame with one of the test patterns. Flat frames consist of large
+ * blocks of a few colors like most game screens, gradient frames change a
+ * little from pixel to pixel like video, and noise frames are random.
+ */
+static void fillFrame(uint16 *frame, int pitch, int width, int height, FrameType type, int bitFormat) {
+	randomSeed = type;
+
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			uint16 color;
+
+			switch (type) {
+			case kFrameFlat:
+				color = (((x / 24) ^ (y / 16)) & 3) * 0x3186;
+				break;
+			case kFrameGradient:
+				if (bitFormat == 555)
+					color = ((x * 32 / width) << 10) | ((y * 32 / height) << 5) | ((x + y) & 31);
+				else
+					color = ((x * 32 / width) << 11) | ((y * 64 / height) << 5) | ((x + y) & 31);
+				break;
+			default:
+				color = nextRandom();
+				if (bitFormat == 555)
+					color &= 0x7FFF;
+				break;
+			}
+
+			frame[y * pitch + x] = color;
+		}
+	}
+}
+
+static double getTime() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+static uint32 checksum(const uint8 *data, int pitch, int width, int height) {
+	uint32 sum = 0;
+
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++)
+			sum = (sum << 5) + (sum >> 27) + data[y * pitch + x];
+	}
+
+	return sum;
+}
+
+int main(int argc, char *argv[]) {
+	// Each scaler runs for at least this long on each frame
+	double minTime = 0.25;
+	const char *only = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+			minTime = atof(argv[++i]);
+		} else if (argv[i][0] != '-' && !only) {
+			only = argv[i];
+		} else {
+			printf("Usage: %s [-t seconds] [scaler]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	static const int sizes[][2] = { { 320, 200 }, { 640, 480 } };
+	static const int bitFormats[] = { 555, 565 };
+
+	printf("%-12s %-6s %-7s %-9s %10s %10s\n", "scaler", "format", "size", "frame", "ms/frame", "checksum");
+
+	for (int f = 0; f < ARRAYSIZE(bitFormats); f++) {
+		InitScalers(bitFormats[f]);
+
+		for (int s = 0; s < ARRAYSIZE(sizes); s++) {
+			const int width = sizes[s][0];
+			const int height = sizes[s][1];
+			const int srcPitch = width + 2 * border;
+
+			uint16 *src = new uint16[srcPitch * (height + 2 * border)];
+			uint8 *dst = new uint8[width * 3 * height * 3 * 2];
+
+			for (int type = 0; type < kFrameTypeCount; type++) {
+				memset(src, 0, srcPitch * (height + 2 * border) * 2);
+				fillFrame(src + border * srcPitch + border, srcPitch, width, height, (FrameType)type, bitFormats[f]);
+
+				for (const Scaler *scaler = scalers; scaler->name; scaler++) {
+					if (only && scumm_stricmp(only, scaler->name))
+						continue;
+
+					const uint8 *srcPtr = (const uint8 *)(src + border * srcPitch + border);
+					const int dstPitch = width * scaler->scale * 2;
+					int runs = 0;
+
+					const double start = getTime();
+					double elapsed;
+					do {
+						scaler->proc(srcPtr, srcPitch * 2, dst, dstPitch, width, height);
+						runs++;
+						elapsed = getTime() - start;
+					} while (elapsed < minTime);
+
+					char size[16];
+					snprintf(size, sizeof(size), "%dx%d", width, height);
+
+					printf("%-12s %-6d %-7s %-9s %10.3f   %08x\n", scaler->name, bitFormats[f], size, frameNames[type],
+						elapsed * 1000 / runs, checksum(dst, dstPitch, dstPitch, height * scaler->scale));
+				}
+			}
+
+			delete[] src;
+			delete[] dst;
+		}
+
+		DestroyScalers();
+	}
+
+	return 0;
+}
@@ -21,6 +21,10 @@
  */
 
 #include "groovie/cell.h"
+#include "groovie/groovie.h"
+
+#include "common/debug.h"
+#include "common/system.h"
 
 namespace Groovie {
 
@@ -28,11 +32,13 @@ CellGame::CellGame() {
 	_startX = _startY = _endX = _endY = 255;
 
 	_stack_index = _boardStackPtr = 0;
-	_flag4 = false;
 	_flag2 = false;
 	_coeff3 = 0;
 
 	_moveCount = 0;
+	_nodeCount = 0;
+
+	initZobrist();
 }
 
 byte CellGame::getStartX() {
@@ -549,7 +555,43 @@ void CellGame::chooseBestMove(int8 color) {
 	_endY = _stack_endXY[0] / 7;
 }
 
-int8 CellGame::calcBestWeight(int8 color1, int8 color2, uint16 depth, int bestWeight) {
+void CellGame::initZobrist() {
+	// A fixed xorshift sequence, so that searches are reproducible
+	uint32 seed = 2463534242U;
+
+	for (int i = 0; i < 2; i++) {
+		for (int j = 0; j < 50; j++) {
+			for (int k = 0; k < 5; k++) {
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+				_zobrist[i][j][k] = seed;
+			}
+		}
+	}
+}
+
+void CellGame::getBoardHash(int8 color, uint16 depth, uint32 &hash, uint32 &check) {
+	// The cell counts in _board[49..52] follow from the cells themselves
+	uint32 state = (depth * 2 + _coeff3 + 1) * 0x9E3779B1;
+
+	hash = _zobrist[0][49][color] ^ state;
+	check = _zobrist[1][49][color] ^ (state >> 7);
+
+	for (int i = 0; i < 49; i++) {
+		hash ^= _zobrist[0][i][_board[i]];
+		check ^= _zobrist[1][i][_board[i]];
+	}
+}
+
+// Alpha-beta search below a move of color2. lowerBound and upperBound are
+// the edges of the search window: weights outside of it are only
+// bounds of the real weight, but anything inside it, including the bounds
+// themselves, is exact. This keeps ties intact for doGame(), which collects
+// all moves of the same weight. The moves are searched in the order they are
+// generated in, since both the first move being exempt from the duplicate
+// check and the tie-breaking in chooseBestMove() depend on that order.
+int8 CellGame::calcBestWeight(int8 color1, int8 color2, uint16 depth, int lowerBound, int upperBound) {
 	int8 res;
 	int8 curColor;
 	bool canMove;
@@ -557,9 +599,24 @@ int8 CellGame::calcBestWeight(int8 color1, int8 color2, uint16 depth, int bestWe
 	uint16 i;
 	int8 currBoardWeight;
 	int8 weight;
+	bool maximize;
+	uint32 hash, check;
 
 	pushBoard();
 	copyFromTempBoard();
+	++_nodeCount;
+
+	getBoardHash(color2, depth, hash, check);
+	TranspositionEntry &entry = _transpositions[hash % kTranspositionTableSize];
+	if (entry.hash == hash && entry.check == check) {
+		if (entry.bound == kBoundExact ||
+				(entry.bound == kBoundUpper && entry.weight < lowerBound) ||
+				(entry.bound == kBoundLower && entry.weight > upperBound)) {
+			popBoard();
+			return entry.weight;
+		}
+	}
+
 	curColor = color2;
 	for (i = 0;; ++i) {
 		if (i >= 4) {
@@ -592,27 +649,27 @@ int8 CellGame::calcBestWeight(int8 color1, int8 color2, uint16 depth, int bestWe
 	}
 	if (_flag1) {
 		popBoard();
-		return bestWeight + 1;
+		return lowerBound + 1;
 	}
 
+	maximize = (color1 == curColor);
+
 	depth -= 1;
 	if (depth) {
 		makeMove(curColor);
 		if (type == 1) {
-			res = calcBestWeight(color1, curColor, depth, bestWeight);
+			res = calcBestWeight(color1, curColor, depth, lowerBound, upperBound);
 		} else {
 			pushShadowBoard();
-			res = calcBestWeight(color1, curColor, depth, bestWeight);
+			res = calcBestWeight(color1, curColor, depth, lowerBound, upperBound);
 			popShadowBoard();
 		}
 	} else {
 		res = getBoardWeight(color1, curColor);
 	}
 
-	if ((res < bestWeight && color1 != curColor) || _flag4) {
-		popBoard();
-		return res;
-	}
+	if ((res < lowerBound && !maximize) || (res > upperBound && maximize))
+		goto done;
 
 	currBoardWeight = _coeff3 + 2 * (2 * _board[color1 + 48] - _board[49] - _board[50] - _board[51] - _board[52]);
 	while (1) {
@@ -628,7 +685,7 @@ int8 CellGame::calcBestWeight(int8 color1, int8 color2, uint16 depth, int bestWe
 			break;
 		if (_flag1) {
 			popBoard();
-			return bestWeight + 1;
+			return lowerBound + 1;
 		}
 		if (_board[55] == 2) {
 			if (getBoardWeight(color1, curColor) == currBoardWeight)
@@ -641,23 +698,39 @@ int8 CellGame::calcBestWeight(int8 color1, int8 color2, uint16 depth, int bestWe
 					_board[56] = 16;
 			}
 		} else {
+			// Narrow the window with what this node already has
+			int childLower = maximize ? MAX<int>(lowerBound, res) : lowerBound;
+			int childUpper = maximize ? upperBound : MIN<int>(upperBound, res);
+
 			makeMove(curColor);
 			if (type != 1) {
 				pushShadowBoard();
-				weight = calcBestWeight(color1, curColor, depth, bestWeight);
+				weight = calcBestWeight(color1, curColor, depth, childLower, childUpper);
 				popShadowBoard();
 			} else {
-				weight = calcBestWeight(color1, curColor, depth, bestWeight);
+				weight = calcBestWeight(color1, curColor, depth, childLower, childUpper);
 			}
 		}
-		if ((weight < res && color1 != curColor) || (weight > res && color1 == curColor))
+		if ((weight < res && !maximize) || (weight > res && maximize))
 			res = weight;
 
-		if ((res < bestWeight && color1 != curColor) || _flag4)
+		if ((res < lowerBound && !maximize) || (res > upperBound && maximize))
 			break;
 	}
+
+done:
 	popBoard();
 
+	entry.hash = hash;
+	entry.check = check;
+	entry.weight = res;
+	if (res < lowerBound)
+		entry.bound = kBoundUpper;
+	else if (res > upperBound)
+		entry.bound = kBoundLower;
+	else
+		entry.bound = kBoundExact;
+
 	return res;
 }
 
@@ -686,12 +759,11 @@ int16 CellGame::doGame(int8 color, int depth) {
 		clearMoves();
 		if (depth) {
 			makeMove(color);
-			_flag4 = false;
 			if (type) {
-				w2 = calcBestWeight(color, color, depth, -127);
+				w2 = calcBestWeight(color, color, depth, -127, 127);
 			} else {
 				pushShadowBoard();
-				w2 = calcBestWeight(color, color, depth, -127);
+				w2 = calcBestWeight(color, color, depth, -127, 127);
 				popShadowBoard();
 			}
 		} else {
@@ -717,12 +789,11 @@ int16 CellGame::doGame(int8 color, int depth) {
 				_coeff3 = 1;
 			if (depth) {
 				makeMove(color);
-				_flag4 = false;
 				if (type) {
-					w1 = calcBestWeight(color, color, depth, w2);
+					w1 = calcBestWeight(color, color, depth, w2, 127);
 				} else {
 					pushShadowBoard();
-					w1 = calcBestWeight(color, color, depth, w2);
+					w1 = calcBestWeight(color, color, depth, w2, 127);
 					popShadowBoard();
 				}
 			} else {
@@ -750,6 +821,12 @@ int16 CellGame::calcMove(int8 color, uint16 depth) {
 
 	_flag1 = false;
 	++_moveCount;
+
+	for (int i = 0; i < kTranspositionTableSize; i++)
+		_transpositions[i].bound = kBoundNone;
+	_nodeCount = 0;
+	uint32 startTime = g_system->getMillis();
+
 	if (depth) {
 		if (depth == 1) {
 			_flag2 = true;
@@ -769,6 +846,10 @@ int16 CellGame::calcMove(int8 color, uint16 depth) {
 		_flag2 = false;
 		result = doGame(color, depth);
 	}
+
+	uint32 elapsed = g_system->getMillis() - startTime;
+	debugC(1, kGroovieDebugCell, "Cell game: searched %d nodes in %d ms (%d nodes/s)", _nodeCount, elapsed, elapsed ? _nodeCount * 1000 / elapsed : 0);
+
 	return result;
 }
 
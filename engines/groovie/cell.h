@@ -65,7 +65,9 @@ private:
 	void makeMove(int8 color);
 	int getBoardWeight(int8 color1, int8 color2);
 	void chooseBestMove(int8 color);
-	int8 calcBestWeight(int8 color1, int8 color2, uint16 depth, int bestWeight);
+	int8 calcBestWeight(int8 color1, int8 color2, uint16 depth, int lowerBound, int upperBound);
+	void initZobrist();
+	void getBoardHash(int8 color, uint16 depth, uint32 &hash, uint32 &check);
 	int16 doGame(int8 color, int depth);
 	int16 calcMove(int8 color, uint16 depth);
 
@@ -88,8 +90,34 @@ private:
 	int _stack_index;
 
 	int _coeff3;
-	bool _flag1, _flag2, _flag4;
+	bool _flag1, _flag2;
 	int _moveCount;
+
+	// Transposition table for calcBestWeight(). Entries are keyed by a pair
+	// of Zobrist hashes of the board, the color that moved last, the
+	// remaining depth and _coeff3, and are cleared before every search.
+	enum {
+		kTranspositionTableSize = 4096
+	};
+
+	enum TranspositionBound {
+		kBoundNone,
+		kBoundExact,
+		kBoundUpper, // weight is at least as high as the real one
+		kBoundLower  // weight is at most as high as the real one
+	};
+
+	struct TranspositionEntry {
+		uint32 hash;
+		uint32 check;
+		int8 weight;
+		byte bound;
+	};
+
+	TranspositionEntry _transpositions[kTranspositionTableSize];
+	uint32 _zobrist[2][50][5]; // 49 cells plus the color that moved last
+
+	uint32 _nodeCount;
 };
 
 } // End of Groovie namespace
@@ -1455,17 +1455,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		&Screen::drawShapeSkipScaleDownwind
 	};
 
-	static const DsLineFunc dsLineFunc[] = {
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind
-	};
-
 	static const DsPlotFunc dsPlotFunc[] = {
 		&Screen::drawShapePlotType0,		// used by Kyra 1 + 2
 		&Screen::drawShapePlotType1,		// used by Kyra 3
@@ -1505,13 +1494,13 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	const int drawFunc = flags & 0x0F;
 	_dsProcessMargin = dsMarginFunc[drawFunc];
 	_dsScaleSkip = dsSkipFunc[drawFunc];
-	_dsProcessLine = dsLineFunc[drawFunc];
 
 	const int ppc = (flags >> 8) & 0x3F;
+	const int ppc3 = (flags & 0x800) ? (((flags >> 8) & 0xF7) & 0x3F) : ppc;
 	_dsPlot = dsPlotFunc[ppc];
-	DsPlotFunc dsPlot2 = dsPlotFunc[ppc], dsPlot3 = dsPlotFunc[ppc];
-	if (flags & 0x800)
-		dsPlot3 = dsPlotFunc[((flags >> 8) & 0xF7) & 0x3F];
+	DsPlotFunc dsPlot2 = dsPlotFunc[ppc], dsPlot3 = dsPlotFunc[ppc3];
+	DsLineFunc dsLine2 = getShapeLineFunc(drawFunc, ppc), dsLine3 = getShapeLineFunc(drawFunc, ppc3);
+	_dsProcessLine = dsLine2;
 
 	if (!_dsPlot || !dsPlot2 || !dsPlot3) {
 		if (!dsPlot2)
@@ -1700,6 +1689,7 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 					if (flags & 0x800)
 						normalPlot = (curY > _maskMinY && curY < _maskMaxY);
 					_dsPlot = normalPlot ? dsPlot2 : dsPlot3;
+					_dsProcessLine = normalPlot ? dsLine2 : dsLine3;
 					(this->*_dsProcessLine)(d, src, cnt, scaleState);
 				}
 				cnt += _dsOffscreenRight;
@@ -1828,92 +1818,179 @@ int Screen::drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt)
 	return found ? 0 : _dsOffscreenScaleVal1;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
+	// Work on local copies, the plotting functions' stores might alias the references
+	uint8 *d = dst;
+	const uint8 *s = src;
+	int n = cnt;
+
 	do {
-		uint8 c = *src++;
+		uint8 c = *s++;
 		if (c) {
-			uint8 *d = dst++;
-			(this->*_dsPlot)(d, c);
-			cnt--;
+			(this->*plot)(d++, c);
+			n--;
 		} else {
-			c = *src++;
-			dst += c;
-			cnt -= c;
+			c = *s++;
+			d += c;
+			n -= c;
 		}
-	} while (cnt > 0);
+	} while (n > 0);
+
+	dst = d;
+	src = s;
+	cnt = n;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
+	// Work on local copies, the plotting functions' stores might alias the references
+	uint8 *d = dst;
+	const uint8 *s = src;
+	int n = cnt;
+
 	do {
-		uint8 c = *src++;
+		uint8 c = *s++;
 		if (c) {
-			uint8 *d = dst--;
-			(this->*_dsPlot)(d, c);
-			cnt--;
+			(this->*plot)(d--, c);
+			n--;
 		} else {
-			c = *src++;
-			dst -= c;
-			cnt -= c;
+			c = *s++;
+			d -= c;
+			n -= c;
 		}
-	} while (cnt > 0);
+	} while (n > 0);
+
+	dst = d;
+	src = s;
+	cnt = n;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
+	// Work on local copies, the plotting functions' stores might alias the references
+	uint8 *d = dst;
+	const uint8 *s = src;
+	int n = cnt;
+	int tmpWidth = _dsTmpWidth;
+	const int scaleW = _dsScaleW;
 	int c = 0;
 
 	do {
 		if ((scaleState & 0x8000) || !(scaleState & 0xFF00)) {
-			c = *src++;
-			_dsTmpWidth--;
+			c = *s++;
+			tmpWidth--;
 			if (c) {
-				scaleState += _dsScaleW;
+				scaleState += scaleW;
 			} else {
-				_dsTmpWidth++;
-				c = *src++;
-				_dsTmpWidth -= c;
-				int r = c * _dsScaleW + scaleState;
-				dst += (r >> 8);
-				cnt -= (r >> 8);
+				tmpWidth++;
+				c = *s++;
+				tmpWidth -= c;
+				int r = c * scaleW + scaleState;
+				d += (r >> 8);
+				n -= (r >> 8);
 				scaleState = r & 0xFF;
 			}
 		} else if (scaleState) {
-			(this->*_dsPlot)(dst++, c);
+			(this->*plot)(d++, c);
 			scaleState -= 0x100;
-			cnt--;
+			n--;
 		}
-	} while (cnt > 0);
+	} while (n > 0);
 
+	dst = d;
+	src = s;
+	_dsTmpWidth = tmpWidth;
 	cnt = -1;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
+	// Work on local copies, the plotting functions' stores might alias the references
+	uint8 *d = dst;
+	const uint8 *s = src;
+	int n = cnt;
+	int tmpWidth = _dsTmpWidth;
+	const int scaleW = _dsScaleW;
 	int c = 0;
 
 	do {
 		if ((scaleState & 0x8000) || !(scaleState & 0xFF00)) {
-			c = *src++;
-			_dsTmpWidth--;
+			c = *s++;
+			tmpWidth--;
 			if (c) {
-				scaleState += _dsScaleW;
+				scaleState += scaleW;
 			} else {
-				_dsTmpWidth++;
-				c = *src++;
-				_dsTmpWidth -= c;
-				int r = c * _dsScaleW + scaleState;
-				dst -= (r >> 8);
-				cnt -= (r >> 8);
+				tmpWidth++;
+				c = *s++;
+				tmpWidth -= c;
+				int r = c * scaleW + scaleState;
+				d -= (r >> 8);
+				n -= (r >> 8);
 				scaleState = r & 0xFF;
 			}
 		} else {
-			(this->*_dsPlot)(dst--, c);
+			(this->*plot)(d--, c);
 			scaleState -= 0x100;
-			cnt--;
+			n--;
 		}
-	} while (cnt > 0);
+	} while (n > 0);
 
+	dst = d;
+	src = s;
+	_dsTmpWidth = tmpWidth;
 	cnt = -1;
 }
 
+#define DS_LINE_FUNCS(plot) { \
+		&Screen::drawShapeProcessLineNoScaleUpwind<plot>, \
+		&Screen::drawShapeProcessLineNoScaleDownwind<plot>, \
+		&Screen::drawShapeProcessLineScaleUpwind<plot>, \
+		&Screen::drawShapeProcessLineScaleDownwind<plot> \
+	}
+
+Screen::DsLineFunc Screen::getShapeLineFunc(int drawFunc, int plotType) {
+	struct LineFuncs {
+		int plotType;
+		DsLineFunc funcs[4];
+	};
+
+	// The plotting types used for most of the shapes in the games
+	static const LineFuncs dsLineFuncs[] = {
+		{  0, DS_LINE_FUNCS(&Screen::drawShapePlotType0) },
+		{  1, DS_LINE_FUNCS(&Screen::drawShapePlotType1) },
+		{  3, DS_LINE_FUNCS(&Screen::drawShapePlotType3_7) },
+		{  4, DS_LINE_FUNCS(&Screen::drawShapePlotType4) },
+		{  5, DS_LINE_FUNCS(&Screen::drawShapePlotType5) },
+		{  7, DS_LINE_FUNCS(&Screen::drawShapePlotType3_7) },
+		{  8, DS_LINE_FUNCS(&Screen::drawShapePlotType8) },
+		{  9, DS_LINE_FUNCS(&Screen::drawShapePlotType9) },
+		{ 11, DS_LINE_FUNCS(&Screen::drawShapePlotType11_15) },
+		{ 12, DS_LINE_FUNCS(&Screen::drawShapePlotType12) },
+		{ 13, DS_LINE_FUNCS(&Screen::drawShapePlotType13) },
+		{ 15, DS_LINE_FUNCS(&Screen::drawShapePlotType11_15) },
+		{ 37, DS_LINE_FUNCS(&Screen::drawShapePlotType37) }
+	};
+
+	static const DsLineFunc dsGenericLineFuncs[] = DS_LINE_FUNCS(&Screen::drawShapePlotGeneric);
+
+	// Bit 0 selects the drawing direction, bit 2 scaling
+	const int kind = ((drawFunc >> 1) & 2) | (drawFunc & 1);
+
+	for (int i = 0; i < ARRAYSIZE(dsLineFuncs); ++i) {
+		if (dsLineFuncs[i].plotType == plotType)
+			return dsLineFuncs[i].funcs[kind];
+	}
+
+	return dsGenericLineFuncs[kind];
+}
+
+#undef DS_LINE_FUNCS
+
+void Screen::drawShapePlotGeneric(uint8 *dst, uint8 cmd) {
+	(this->*_dsPlot)(dst, cmd);
+}
+
 void Screen::drawShapePlotType0(uint8 *dst, uint8 cmd) {
 	*dst = cmd;
 }
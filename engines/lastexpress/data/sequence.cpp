@@ -30,6 +30,14 @@
 
 namespace LastExpress {
 
+static bool isEmptyRow(const byte *row, uint16 width) {
+	for (uint16 i = 0; i < width; i++)
+		if (row[i])
+			return false;
+
+	return true;
+}
+
 void FrameInfo::read(Common::SeekableReadStream *in, bool isSequence) {
 	// Save the current position
 	int32 basePos = in->pos();
@@ -76,7 +84,7 @@ void FrameInfo::read(Common::SeekableReadStream *in, bool isSequence) {
 
 // AnimFrame
 
-AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool ignoreSubtype) : _palette(NULL), _ignoreSubtype(ignoreSubtype) {
+AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool ignoreSubtype) : _top(0), _palette(NULL), _ignoreSubtype(ignoreSubtype) {
 	_palSize = 1;
 	// TODO: use just the needed rectangle
 	_image.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
@@ -120,6 +128,8 @@ AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool ig
 	readPalette(in, f);
 	_rect = Common::Rect((int16)f.xPos1, (int16)f.yPos1, (int16)f.xPos2, (int16)f.yPos2);
 	//_rect.debugPrint(0, "Frame rect:");
+
+	crop();
 }
 
 AnimFrame::~AnimFrame() {
@@ -129,14 +139,44 @@ AnimFrame::~AnimFrame() {
 
 Common::Rect AnimFrame::draw(Graphics::Surface *s) {
 	byte *inp = (byte *)_image.pixels;
-	uint16 *outp = (uint16 *)s->pixels;
-	for (int i = 0; i < 640 * 480; i++, inp++, outp++) {
+	uint16 *outp = (uint16 *)s->pixels + 640 * _top;
+	for (int i = 0; i < 640 * _image.h; i++, inp++, outp++) {
 		if (*inp)
 			*outp = _palette[*inp];
 	}
 	return _rect;
 }
 
+uint32 AnimFrame::getSize() const {
+	return sizeof(AnimFrame) + _image.pitch * _image.h + _palSize * sizeof(uint16);
+}
+
+// Frames are decoded to a full screen image, but usually only cover part of
+// it: only keep the rows with visible pixels, as drawing skips all others.
+void AnimFrame::crop() {
+	int top = 0;
+	int bottom = _image.h;
+
+	while (top < bottom && isEmptyRow((byte *)_image.getBasePtr(0, top), _image.w))
+		top++;
+
+	while (bottom > top && isEmptyRow((byte *)_image.getBasePtr(0, bottom - 1), _image.w))
+		bottom--;
+
+	if (top == 0 && bottom == _image.h)
+		return;
+
+	Graphics::Surface cropped;
+	if (bottom > top) {
+		cropped.create(_image.w, (uint16)(bottom - top), _image.format);
+		memcpy(cropped.pixels, _image.getBasePtr(0, top), _image.pitch * (bottom - top));
+	}
+
+	_image.free();
+	_image = cropped;
+	_top = (uint16)top;
+}
+
 void AnimFrame::readPalette(Common::SeekableReadStream *in, const FrameInfo &f) {
 	// Read the palette
 	in->seek((int)f.paletteOffset);
@@ -343,8 +383,9 @@ void Sequence::reset() {
 	_stream = NULL;
 }
 
-Sequence *Sequence::load(Common::String name, Common::SeekableReadStream *stream, byte field30) {
+Sequence *Sequence::load(Common::String name, Common::SeekableReadStream *stream, byte field30, FrameCache *cache) {
 	Sequence *sequence = new Sequence(name);
+	sequence->setCache(cache);
 
 	if (!sequence->load(stream, field30)) {
 		delete sequence;
@@ -420,6 +461,186 @@ AnimFrame *Sequence::getFrame(uint16 index) {
 	return new AnimFrame(_stream, *frame);
 }
 
+//////////////////////////////////////////////////////////////////////////
+// FrameCache
+//////////////////////////////////////////////////////////////////////////
+FrameCache::FrameCache(uint32 budget) : _head(NULL), _tail(NULL), _size(0), _budget(budget) {
+	resetStats();
+}
+
+FrameCache::~FrameCache() {
+	clear();
+}
+
+AnimFrame *FrameCache::get(Sequence *sequence, uint16 index) {
+	// Skip "invalid" frames
+	if (sequence->getFrameInfo(index)->compressionType == 0)
+		return NULL;
+
+	Entry *entry = find(sequence, index);
+	if (entry) {
+		_hits++;
+		if (entry->preloaded) {
+			_preloadHits++;
+			entry->preloaded = false;
+		}
+
+		detach(entry);
+		pushFront(entry);
+
+		return entry->frame;
+	}
+
+	_misses++;
+
+	entry = insert(sequence, index);
+	return entry ? entry->frame : NULL;
+}
+
+bool FrameCache::preload(Sequence *sequence, uint16 index) {
+	if (sequence->getFrameInfo(index)->compressionType == 0)
+		return false;
+
+	if (find(sequence, index))
+		return false;
+
+	Entry *entry = insert(sequence, index);
+	if (!entry)
+		return false;
+
+	entry->preloaded = true;
+	_preloads++;
+
+	return true;
+}
+
+void FrameCache::clear() {
+	while (_head) {
+		Entry *entry = _head;
+		_head = entry->next;
+
+		delete entry->frame;
+		delete entry;
+	}
+
+	_entries.clear();
+	_tail = NULL;
+	_size = 0;
+}
+
+void FrameCache::setBudget(uint32 budget) {
+	_budget = budget;
+	evict();
+}
+
+Common::String FrameCache::toString() const {
+	uint32 lookups = _hits + _misses;
+
+	Common::String ret = "";
+	ret += Common::String::format("Frames: %d (%d KB / %d KB)\n", _entries.size(), _size / 1024, _budget / 1024);
+	ret += Common::String::format("Hits: %d  -  Misses: %d  -  Hit rate: %d%%\n", _hits, _misses, lookups ? _hits * 100 / lookups : 0);
+	ret += Common::String::format("Preloaded: %d  -  Used: %d\n", _preloads, _preloadHits);
+	ret += Common::String::format("Evictions: %d\n", _evictions);
+
+	return ret;
+}
+
+void FrameCache::resetStats() {
+	_hits = 0;
+	_misses = 0;
+	_preloads = 0;
+	_preloadHits = 0;
+	_evictions = 0;
+}
+
+FrameCache::Entry *FrameCache::find(Sequence *sequence, uint16 index) {
+	EntryMap::iterator it = _entries.find(FrameKey(sequence->getName(), index));
+	if (it == _entries.end())
+		return NULL;
+
+	// Drop frames decoded with a different position or data, so they get
+	// decoded again from the current frame information
+	Entry *entry = it->_value;
+	const FrameInfo *info = sequence->getFrameInfo(index);
+	if (entry->info.dataOffset != info->dataOffset
+	 || entry->info.paletteOffset != info->paletteOffset
+	 || entry->info.xPos1 != info->xPos1
+	 || entry->info.yPos1 != info->yPos1
+	 || entry->info.xPos2 != info->xPos2
+	 || entry->info.yPos2 != info->yPos2
+	 || entry->info.initialSkip != info->initialSkip
+	 || entry->info.decompressedEndOffset != info->decompressedEndOffset
+	 || entry->info.compressionType != info->compressionType) {
+		remove(entry);
+		return NULL;
+	}
+
+	return entry;
+}
+
+FrameCache::Entry *FrameCache::insert(Sequence *sequence, uint16 index) {
+	AnimFrame *frame = sequence->getFrame(index);
+	if (!frame)
+		return NULL;
+
+	Entry *entry = new Entry(FrameKey(sequence->getName(), index));
+	entry->info = *sequence->getFrameInfo(index);
+	entry->frame = frame;
+	entry->size = frame->getSize();
+
+	_entries[entry->key] = entry;
+	pushFront(entry);
+	_size += entry->size;
+
+	evict();
+
+	return entry;
+}
+
+void FrameCache::remove(Entry *entry) {
+	detach(entry);
+	_entries.erase(entry->key);
+	_size -= entry->size;
+
+	delete entry->frame;
+	delete entry;
+}
+
+void FrameCache::detach(Entry *entry) {
+	if (entry->prev)
+		entry->prev->next = entry->next;
+	else
+		_head = entry->next;
+
+	if (entry->next)
+		entry->next->prev = entry->prev;
+	else
+		_tail = entry->prev;
+
+	entry->prev = entry->next = NULL;
+}
+
+void FrameCache::pushFront(Entry *entry) {
+	entry->prev = NULL;
+	entry->next = _head;
+
+	if (_head)
+		_head->prev = entry;
+	else
+		_tail = entry;
+
+	_head = entry;
+}
+
+void FrameCache::evict() {
+	// The most recently used frame is never evicted, as it might just have
+	// been handed out
+	while (_size > _budget && _tail && _tail != _head) {
+		remove(_tail);
+		_evictions++;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // SequenceFrame
 SequenceFrame::~SequenceFrame() {
@@ -434,6 +655,12 @@ Common::Rect SequenceFrame::draw(Graphics::Surface *surface) {
 	if (!_sequence || _frame >= _sequence->count())
 		return Common::Rect();
 
+	if (_sequence->getCache()) {
+		AnimFrame *f = _sequence->getCache()->get(_sequence, _frame);
+
+		return f ? f->draw(surface) : Common::Rect();
+	}
+
 	AnimFrame *f = _sequence->getFrame(_frame);
 	if (!f)
 		return Common::Rect();
@@ -460,6 +687,13 @@ bool SequenceFrame::nextFrame() {
 	return setFrame(_frame + 1);
 }
 
+bool SequenceFrame::preloadNextFrame() {
+	if (!_sequence || !_sequence->getCache() || _frame + 1 >= _sequence->count())
+		return false;
+
+	return _sequence->getCache()->preload(_sequence, _frame + 1);
+}
+
 FrameInfo *SequenceFrame::getInfo() {
 	if (!_sequence)
 		error("[SequenceFrame::getInfo] Invalid sequence");
@@ -475,7 +709,8 @@ Common::String SequenceFrame::getName() {
 }
 
 bool SequenceFrame::equal(const SequenceFrame *other) const {
-	return _sequence->getName() == other->_sequence->getName() && _frame == other->_frame;
+	// Compare the frame indices first, as comparing the names copies them
+	return _frame == other->_frame && _sequence->getName() == other->_sequence->getName();
 }
 
 } // End of namespace LastExpress
@@ -75,6 +75,8 @@
 #include "lastexpress/shared.h"
 
 #include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/rect.h"
 #include "common/str.h"
 
@@ -84,6 +86,8 @@ class SeekableReadStream;
 
 namespace LastExpress {
 
+class FrameCache;
+
 enum FrameSubType {
 	kFrameTypeNone = 0,
 	kFrameType1 = 1,
@@ -134,7 +138,11 @@ public:
 	~AnimFrame();
 	Common::Rect draw(Graphics::Surface *s);
 
+	// Memory used by the decoded frame
+	uint32 getSize() const;
+
 private:
+	void crop();
 	void decomp3(Common::SeekableReadStream *in, const FrameInfo &f);
 	void decomp4(Common::SeekableReadStream *in, const FrameInfo &f);
 	void decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byte mask, byte shift);
@@ -143,7 +151,8 @@ private:
 	void decompFF(Common::SeekableReadStream *in, const FrameInfo &f);
 	void readPalette(Common::SeekableReadStream *in, const FrameInfo &f);
 
-	Graphics::Surface _image;
+	Graphics::Surface _image;     ///< Only holds the rows starting at _top which have visible pixels
+	uint16 _top;
 	uint16 _palSize;
 	uint16 *_palette;
 	Common::Rect _rect;
@@ -152,10 +161,10 @@ private:
 
 class Sequence {
 public:
-	Sequence(Common::String name) : _stream(NULL), _isLoaded(false), _name(name), _field30(15) {}
+	Sequence(Common::String name) : _stream(NULL), _isLoaded(false), _name(name), _field30(15), _cache(NULL) {}
 	~Sequence();
 
-	static Sequence *load(Common::String name, Common::SeekableReadStream *stream = NULL, byte field30 = 15);
+	static Sequence *load(Common::String name, Common::SeekableReadStream *stream = NULL, byte field30 = 15, FrameCache *cache = NULL);
 
 	bool load(Common::SeekableReadStream *stream, byte field30 = 15);
 
@@ -168,6 +177,10 @@ public:
 
 	bool isLoaded() { return _isLoaded; }
 
+	// Frames are drawn from the cache, if any
+	FrameCache *getCache() { return _cache; }
+	void setCache(FrameCache *cache) { _cache = cache; }
+
 private:
 	static const uint32 _sequenceHeaderSize = 8;
 	static const uint32 _sequenceFrameSize = 68;
@@ -180,6 +193,96 @@ private:
 
 	Common::String _name;
 	byte _field30; // used when copying sequences
+
+	FrameCache *_cache;
+};
+
+/**
+ * Keeps decoded frames around, so that frames drawn again (even from another
+ * instance of the same sequence) don't need to be decoded every time.
+ *
+ * Frames are evicted in least recently used order once their total size
+ * goes over the memory budget. A cached frame is only reused while the frame
+ * information it was decoded from is unchanged, as some sequences (like the
+ * beetle's) get their frames moved around before being drawn.
+ */
+class FrameCache {
+public:
+	FrameCache(uint32 budget = kDefaultBudget);
+	~FrameCache();
+
+	/**
+	 * Get a frame from the cache, decoding it on a miss.
+	 *
+	 * The frame is owned by the cache and only stays valid until the next
+	 * call to get() or preload().
+	 */
+	AnimFrame *get(Sequence *sequence, uint16 index);
+
+	/**
+	 * Decode a frame ahead of time.
+	 *
+	 * @return true if the frame was decoded, false if it was already cached
+	 */
+	bool preload(Sequence *sequence, uint16 index);
+
+	void clear();
+
+	uint32 getBudget() const { return _budget; }
+	void setBudget(uint32 budget);
+
+	Common::String toString() const;
+	void resetStats();
+
+private:
+	static const uint32 kDefaultBudget = 16 * 1024 * 1024;
+
+	struct FrameKey {
+		Common::String sequence;
+		uint16 index;
+
+		FrameKey(const Common::String &seq, uint16 idx) : sequence(seq), index(idx) {}
+		bool operator==(const FrameKey &other) const { return index == other.index && sequence.equalsIgnoreCase(other.sequence); }
+	};
+
+	struct FrameKey_Hash {
+		uint operator()(const FrameKey &key) const { return Common::hashit_lower(key.sequence) ^ key.index; }
+	};
+
+	// Entries are kept in a list from most to least recently used
+	struct Entry {
+		FrameKey key;
+		FrameInfo info;
+		AnimFrame *frame;
+		uint32 size;
+		bool preloaded;
+		Entry *prev;
+		Entry *next;
+
+		Entry(const FrameKey &k) : key(k), frame(NULL), size(0), preloaded(false), prev(NULL), next(NULL) {}
+	};
+
+	typedef Common::HashMap<FrameKey, Entry *, FrameKey_Hash> EntryMap;
+
+	Entry *find(Sequence *sequence, uint16 index);
+	Entry *insert(Sequence *sequence, uint16 index);
+	void remove(Entry *entry);
+	void detach(Entry *entry);
+	void pushFront(Entry *entry);
+	void evict();
+
+	EntryMap _entries;
+	Entry *_head;
+	Entry *_tail;
+	uint32 _size;
+	uint32 _budget;
+
+	// Statistics
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _preloads;
+	uint32 _preloadHits;
+	uint32 _evictions;
 };
 
 class SequenceFrame : public Drawable {
@@ -193,6 +296,9 @@ public:
 	uint32 getFrame() { return _frame; }
 	bool nextFrame();
 
+	// Decode the next frame into the sequence cache
+	bool preloadNextFrame();
+
 	Common::String getName();
 	FrameInfo *getInfo();
 
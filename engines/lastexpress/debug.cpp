@@ -1056,6 +1056,8 @@ bool Debugger::cmdShow(int argc, const char **argv) {
 			OUTPUT_DUMP("SavePoints", getSavePoints()->toString().c_str());
 		} else if (name == "scene" || name == "sc") {
 			OUTPUT_DUMP("Current scene", getScenes()->get(getState()->scene)->toString().c_str());
+		} else if (name == "framecache" || name == "fc") {
+			OUTPUT_DUMP("Frame cache", _engine->getResourceManager()->getFrameCache()->toString().c_str());
 		} else {
 			goto label_error;
 		}
@@ -1070,6 +1072,7 @@ label_error:
 		DebugPrintf("          objects / obj\n");
 		DebugPrintf("          savepoints / pt\n");
 		DebugPrintf("          scene / sc\n");
+		DebugPrintf("          framecache / fc\n");
 	}
 
 	return true;
@@ -89,6 +89,13 @@ void Beetle::load() {
 	_data->sequences.push_back(loadSequence("BL315.seq"));
 	_data->sequences.push_back(loadSequence("BL180.seq"));
 
+	// The beetle frames are moved around before every draw (see updateFrame),
+	// so decoding them again each time is cheaper than caching them
+	for (uint i = 0; i < _data->sequences.size(); i++) {
+		if (_data->sequences[i])
+			_data->sequences[i]->setCache(NULL);
+	}
+
 	// Init fields
 	_data->field_74 = 0;
 
@@ -31,7 +31,7 @@
 
 namespace LastExpress {
 
-SavePoints::SavePoints(LastExpressEngine *engine) : _engine(engine) {
+SavePoints::SavePoints(LastExpressEngine *engine) : _engine(engine), _savepointsFirst(0), _savepointsCount(0) {
 	for (int i = 0; i < 40; i++)
 		_callbacks[i] = NULL;
 }
@@ -45,34 +45,39 @@ SavePoints::~SavePoints() {
 // Savepoints
 //////////////////////////////////////////////////////////////////////////
 void SavePoints::push(EntityIndex entity2, EntityIndex entity1, ActionIndex action, uint32 param) {
-	if (_savepoints.size() >= _savePointsMaxSize)
-		return;
-
 	SavePoint point;
 	point.entity1 = entity1;
 	point.action = action;
 	point.entity2 = entity2;
 	point.param.intValue = param;
 
-	_savepoints.push_back(point);
+	push(point);
 }
 
 void SavePoints::push(EntityIndex entity2, EntityIndex entity1, ActionIndex action, const char *param) {
-	if (_savepoints.size() >= _savePointsMaxSize)
-		return;
-
 	SavePoint point;
 	point.entity1 = entity1;
 	point.action = action;
 	point.entity2 = entity2;
 	strcpy((char *)&point.param.charValue, param);
 
-	_savepoints.push_back(point);
+	push(point);
+}
+
+void SavePoints::push(const SavePoint &point) {
+	if (_savepointsCount >= _savePointsMaxSize)
+		return;
+
+	get(_savepointsCount) = point;
+	++_savepointsCount;
 }
 
 SavePoint SavePoints::pop() {
-	SavePoint point = _savepoints.front();
-	_savepoints.pop_front();
+	SavePoint point = _savepoints[_savepointsFirst];
+
+	_savepointsFirst = (_savepointsFirst + 1) % _savePointsMaxSize;
+	--_savepointsCount;
+
 	return point;
 }
 
@@ -86,7 +91,7 @@ void SavePoints::pushAll(EntityIndex entity, ActionIndex action, uint32 param) {
 
 // Process all savepoints
 void SavePoints::process() {
-	while (_savepoints.size() > 0 && getFlags()->isGameRunning) {
+	while (_savepointsCount > 0 && getFlags()->isGameRunning) {
 		SavePoint savepoint = pop();
 
 		// If this is a data savepoint, update the entity
@@ -104,7 +109,8 @@ void SavePoints::process() {
 }
 
 void SavePoints::reset() {
-	_savepoints.clear();
+	_savepointsFirst = 0;
+	_savepointsCount = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -253,7 +259,7 @@ void SavePoints::saveLoadWithSerializer(Common::Serializer &s) {
 	}
 
 	// Number of savepoints
-	uint32 numSavepoints = _savepoints.size();
+	uint32 numSavepoints = _savepointsCount;
 	s.syncAsUint32LE(numSavepoints);
 
 	// Savepoints
@@ -265,17 +271,18 @@ void SavePoints::saveLoadWithSerializer(Common::Serializer &s) {
 			s.syncAsUint32LE(point.entity2);
 			s.syncAsUint32LE(point.param.intValue);
 
-			_savepoints.push_back(point);
+			push(point);
 
-			if (_savepoints.size() >= _savePointsMaxSize)
+			if (_savepointsCount >= _savePointsMaxSize)
 				break;
 		}
 	} else {
-		for (Common::List<SavePoint>::iterator it = _savepoints.begin(); it != _savepoints.end(); ++it) {
-			s.syncAsUint32LE((*it).entity1);
-			s.syncAsUint32LE((*it).action);
-			s.syncAsUint32LE((*it).entity2);
-			s.syncAsUint32LE((*it).param.intValue);
+		for (uint32 i = 0; i < _savepointsCount; i++) {
+			SavePoint &point = get(i);
+			s.syncAsUint32LE(point.entity1);
+			s.syncAsUint32LE(point.action);
+			s.syncAsUint32LE(point.entity2);
+			s.syncAsUint32LE(point.param.intValue);
 		}
 	}
 }
@@ -291,8 +298,8 @@ Common::String SavePoints::toString() {
 		ret += _data[i].toString() + "\n";
 
 	ret += "\nSavepoints\n";
-	for (Common::List<SavePoint>::iterator it = _savepoints.begin(); it != _savepoints.end(); ++it)
-		ret += (*it).toString() + "\n";
+	for (uint32 i = 0; i < _savepointsCount; i++)
+		ret += get(i).toString() + "\n";
 
 	return ret;
 }
@@ -126,18 +126,25 @@ public:
 	 */
 	Common::String toString();
 
-	uint32 count() { return _savepoints.size(); }
+	uint32 count() { return _savepointsCount; }
 
 private:
 	static const uint32 _savePointsMaxSize = 128;
 
 	LastExpressEngine *_engine;
 
-	Common::List<SavePoint> _savepoints;    ///< could be a queue, but we need to be able to iterate on the items
+	// Pending savepoints, queued in a ring buffer so that pushing and processing
+	// them every tick does not allocate (or walk a list to get its size)
+	SavePoint _savepoints[_savePointsMaxSize];
+	uint32 _savepointsFirst;
+	uint32 _savepointsCount;
+
 	Common::Array<SavePointData> _data;
 	Callback *_callbacks[40];
 
+	void push(const SavePoint &point);
 	SavePoint pop();
+	SavePoint &get(uint32 index) { return _savepoints[(_savepointsFirst + index) % _savePointsMaxSize]; }
 	bool updateEntityFromData(const SavePoint &point);
 };
 
@@ -739,6 +739,17 @@ void SceneManager::resetQueue() {
 	_queue.clear();
 }
 
+// Decode the frames following the queued ones, as they are likely to be
+// drawn on the next update. Stops once the deadline (in ms) is reached.
+void SceneManager::preloadFrames(uint32 deadline) {
+	for (Common::List<SequenceFrame *>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
+		if ((int32)(deadline - _engine->_system->getMillis()) <= 0)
+			break;
+
+		(*i)->preloadNextFrame();
+	}
+}
+
 void SceneManager::setCoordinates(const Common::Rect &rect) {
 	_flagCoordinates = true;
 
@@ -80,6 +80,7 @@ public:
 	void resetQueue();
 	void setCoordinates(SequenceFrame *frame);
 	void setCoordinates(const Common::Rect &rect);
+	void preloadFrames(uint32 deadline);
 
 	// Helpers
 	SceneIndex getSceneIndexFromPosition(CarIndex car, Position position, int param3 = -1);
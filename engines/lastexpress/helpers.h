@@ -75,8 +75,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 // Sequences
-#define loadSequence(name) Sequence::load(name, getArchive(name))
-#define loadSequence1(name, field30) Sequence::load(name, getArchive(name), field30)
+#define loadSequence(name) Sequence::load(name, getArchive(name), 15, _engine->getResourceManager()->getFrameCache())
+#define loadSequence1(name, field30) Sequence::load(name, getArchive(name), field30, _engine->getResourceManager()->getFrameCache())
 
 #define clearBg(type) _engine->getGraphicsManager()->clear(type)
 #define showScene(index, type) _engine->getGraphicsManager()->draw(getScenes()->get(index), type);
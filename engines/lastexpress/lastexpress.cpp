@@ -261,7 +261,15 @@ bool LastExpressEngine::handleEvents() {
 	// Update the screen
 	_graphicsMan->update();
 	_system->updateScreen();
-	_system->delayMillis(50);
+
+	// Use the time until the next update to decode upcoming frames
+	uint32 nextUpdate = _system->getMillis() + 50;
+	if (_sceneMan)
+		_sceneMan->preloadFrames(nextUpdate - 10);
+
+	int32 delay = (int32)(nextUpdate - _system->getMillis());
+	if (delay > 0)
+		_system->delayMillis((uint)delay);
 
 	// The event loop may have triggered the quit status. In this case,
 	// stop the execution.
@@ -25,6 +25,7 @@
 #include "lastexpress/data/background.h"
 #include "lastexpress/data/cursor.h"
 #include "lastexpress/data/font.h"
+#include "lastexpress/data/sequence.h"
 
 #include "lastexpress/debug.h"
 #include "lastexpress/helpers.h"
@@ -41,10 +42,13 @@ const char *archiveCD2Path = "cd2.hpf";
 const char *archiveCD3Path = "cd3.hpf";
 
 ResourceManager::ResourceManager(bool isDemo) : _isDemo(isDemo) {
+	_frameCache = new FrameCache();
 }
 
 ResourceManager::~ResourceManager() {
 	reset();
+
+	SAFE_DELETE(_frameCache);
 }
 
 bool ResourceManager::isArchivePresent(ArchiveIndex type) {
@@ -108,6 +112,9 @@ void ResourceManager::reset() {
 		SAFE_DELETE(*it);
 
 	_archives.clear();
+
+	// Frames from other archives might have the same name
+	_frameCache->clear();
 }
 
 bool ResourceManager::loadArchive(const Common::String &name) {
@@ -33,6 +33,7 @@ namespace LastExpress {
 class Background;
 class Cursor;
 class Font;
+class FrameCache;
 
 class ResourceManager : public Common::Archive {
 public:
@@ -55,8 +56,12 @@ public:
 	Cursor *loadCursor() const;
 	Font *loadFont() const;
 
+	// Decoded sequence frames
+	FrameCache *getFrameCache() const { return _frameCache; }
+
 private:
 	bool _isDemo;
+	FrameCache *_frameCache;
 
 	bool loadArchive(const Common::String &name);
 	void reset();
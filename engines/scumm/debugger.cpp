@@ -29,7 +29,9 @@
 #include "scumm/actor.h"
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
+#include "scumm/he/intern_he.h"
 #include "scumm/imuse/imuse.h"
+#include "scumm/imuse_digi/dimuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
@@ -79,6 +81,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	DCmd_Register("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	DCmd_Register("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
 	DCmd_Register("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
+	DCmd_Register("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
 
 	if (_vm->_game.id == GID_LOOM)
 		DCmd_Register("drafts",  WRAP_METHOD(ScummDebugger, Cmd_PrintDraft));
@@ -142,6 +145,25 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 				DebugPrintf("Specify a music resource # from 1-255.\n");
 			}
 			return true;
+#ifdef ENABLE_SCUMM_7_8
+		} else if (!strcmp(argv[1], "stats")) {
+			if (!_vm->_imuseDigital) {
+				DebugPrintf("Statistics are only available for iMuse Digital.\n");
+				return true;
+			}
+
+			const IMuseDigital *imuseDigital = _vm->_imuseDigital;
+			const BundleDirCache *cache = imuseDigital->getBundleDirCache();
+			const uint32 feedCount = imuseDigital->getFeedCount();
+
+			DebugPrintf("Bundle blocks: %d hits, %d misses, %d prefetched\n",
+				cache->getBlockHits(), cache->getBlockMisses(), cache->getBlocksPrefetched());
+			DebugPrintf("Feeds: %d, total %d ms, average %d ms, max %d ms\n", feedCount,
+				imuseDigital->getFeedTimeTotal(), feedCount ? imuseDigital->getFeedTimeTotal() / feedCount : 0,
+				imuseDigital->getFeedTimeMax());
+			DebugPrintf("Prefetch: total %d ms, on the engine thread\n", imuseDigital->getPrefetchTimeTotal());
+			return true;
+#endif
 		} else if (!strcmp(argv[1], "stop")) {
 			if (argc > 2 && (!strcmp(argv[2], "all") || atoi(argv[2]) != 0)) {
 				if (!strcmp(argv[2], "all")) {
@@ -162,6 +184,9 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 	DebugPrintf("  panic - Stop all music tracks\n");
 	DebugPrintf("  play # - Play a music resource\n");
 	DebugPrintf("  stop # - Stop a music resource\n");
+#ifdef ENABLE_SCUMM_7_8
+	DebugPrintf("  stats - Show iMuse Digital bundle cache statistics\n");
+#endif
 	return true;
 }
 
@@ -311,6 +336,48 @@ bool ScummDebugger::Cmd_ImportRes(int argc, const char** argv) {
 	return true;
 }
 
+extern const char *nameOfResType(ResType type);
+
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager *res = _vm->_res;
+	uint32 totalNum = 0, lockedNum = 0, lockedSize = 0;
+
+	DebugPrintf("+-----------------+------+---------+\n");
+	DebugPrintf("|type             |loaded|    bytes|\n");
+	DebugPrintf("+-----------------+------+---------+\n");
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		uint32 num = 0, size = 0;
+
+		for (ResId idx = 0; idx < res->_types[type].size(); idx++) {
+			if (!res->_types[type][idx]._address)
+				continue;
+
+			num++;
+			size += res->_types[type][idx]._size;
+			if (res->isLocked(type, idx)) {
+				lockedNum++;
+				lockedSize += res->_types[type][idx]._size;
+			}
+		}
+
+		if (num)
+			DebugPrintf("|%-17s|%6d|%9d|\n", nameOfResType(type), num, size);
+		totalNum += num;
+	}
+	DebugPrintf("+-----------------+------+---------+\n");
+
+	DebugPrintf("Resident: %d resources, %d bytes (locked: %d, %d bytes)\n", totalNum, res->getAllocatedSize(), lockedNum, lockedSize);
+	DebugPrintf("Allocations: %d, evictions: %d, generation: %d\n", res->getNumAllocations(), res->getNumEvictions(), res->getGeneration());
+
+#ifdef ENABLE_HE
+	if (_vm->_game.heversion >= 71) {
+		const Wiz *wiz = ((ScummEngine_v71he *)_vm)->_wiz;
+		DebugPrintf("Wiz cache: %d bytes, hits: %d, misses: %d, evictions: %d\n", wiz->getWizCacheSize(), wiz->getWizCacheHits(), wiz->getWizCacheMisses(), wiz->getWizCacheEvictions());
+	}
+#endif
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintScript(int argc, const char **argv) {
 	int i;
 	ScriptSlot *ss = _vm->vm.slot;
@@ -261,6 +261,8 @@ void ScummEngine_v70he::o70_resourceRoutines() {
 		break;
 	case 192:
 		resid = pop();
+		if (_game.heversion >= 71)
+			((ScummEngine_v71he *)this)->_wiz->invalidateWizCache(resid);
 		_res->nukeResource(rtImage, resid);
 		break;
 	case 201:
@@ -40,6 +40,17 @@ Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+
+	memset(&_cache, 0, sizeof(_cache));
+	_cacheSize = 0;
+	_cacheClock = 0;
+	_cacheHits = 0;
+	_cacheMisses = 0;
+	_cacheEvictions = 0;
+}
+
+Wiz::~Wiz() {
+	clearWizCache();
 }
 
 void Wiz::clearWizBuffer() {
@@ -413,6 +424,164 @@ void Wiz::copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType,
 	}
 }
 
+void Wiz::invalidateWizCache(int resNum) {
+	for (int i = 0; i < kWizCacheEntries; ++i) {
+		if (_cache[i].pixels && _cache[i].resNum == resNum)
+			freeWizCacheEntry(_cache[i]);
+	}
+}
+
+void Wiz::clearWizCache() {
+	for (int i = 0; i < kWizCacheEntries; ++i) {
+		if (_cache[i].pixels)
+			freeWizCacheEntry(_cache[i]);
+	}
+}
+
+void Wiz::freeWizCacheEntry(WizCacheEntry &entry) {
+	_cacheSize -= entry.width * entry.height * 2;
+	free(entry.pixels);
+	free(entry.mask);
+	memset(&entry, 0, sizeof(entry));
+}
+
+const WizCacheEntry *Wiz::getCachedWizImage(int resNum, int state, const uint8 *wizd, int width, int height) {
+	const uint32 size = width * height * 2;
+	if (width <= 0 || height <= 0 || size > kWizCacheBudget / 4)
+		return NULL;
+
+	++_cacheClock;
+
+	WizCacheEntry *slot = NULL;
+	for (int i = 0; i < kWizCacheEntries; ++i) {
+		WizCacheEntry &entry = _cache[i];
+		if (!entry.pixels) {
+			if (!slot)
+				slot = &entry;
+		} else if (entry.resNum == resNum && entry.state == state) {
+			// A resource which was reloaded or replaced has a new address
+			if (entry.wizd == wizd && entry.width == width && entry.height == height) {
+				entry.lastUsed = _cacheClock;
+				++_cacheHits;
+				return &entry;
+			}
+			freeWizCacheEntry(entry);
+			if (!slot)
+				slot = &entry;
+		}
+	}
+
+	++_cacheMisses;
+
+	// Drop the least recently drawn images until the new one fits
+	while (!slot || _cacheSize + size > kWizCacheBudget) {
+		WizCacheEntry *oldest = NULL;
+		for (int i = 0; i < kWizCacheEntries; ++i) {
+			if (_cache[i].pixels && (!oldest || _cache[i].lastUsed < oldest->lastUsed))
+				oldest = &_cache[i];
+		}
+		assert(oldest);
+		freeWizCacheEntry(*oldest);
+		++_cacheEvictions;
+		if (!slot)
+			slot = oldest;
+	}
+
+	// Decode as 16 bit colors, so that 0xFFFF can mark the pixels which
+	// the RLE data skips over.
+	uint16 *decoded = (uint16 *)malloc(size);
+	slot->pixels = (uint8 *)malloc(width * height);
+	slot->mask = (uint8 *)malloc(width * height);
+	if (!decoded || !slot->pixels || !slot->mask) {
+		free(decoded);
+		free(slot->pixels);
+		free(slot->mask);
+		slot->pixels = NULL;
+		slot->mask = NULL;
+		return NULL;
+	}
+
+	memset(decoded, 0xFF, size);
+	decompressWizImage<kWizCopy>((uint8 *)decoded, width * 2, kDstMemory, wizd, Common::Rect(width, height), 0, NULL, NULL, 2);
+	for (int i = 0; i < width * height; ++i) {
+		const uint16 color = READ_LE_UINT16(decoded + i);
+		slot->pixels[i] = (uint8)color;
+		slot->mask[i] = (color != 0xFFFF);
+	}
+	free(decoded);
+
+	slot->resNum = resNum;
+	slot->state = state;
+	slot->wizd = wizd;
+	slot->width = width;
+	slot->height = height;
+	slot->lastUsed = _cacheClock;
+	_cacheSize += size;
+
+	return slot;
+}
+
+void Wiz::drawCachedWizImage(uint8 *dst, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const WizCacheEntry &entry, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	Common::Rect r1, r2;
+	if (calcClipRects(dstw, dsth, srcx, srcy, entry.width, entry.height, rect, r1, r2)) {
+		dst += r2.top * dstPitch + r2.left * bitDepth;
+		if (flags & kWIFFlipY) {
+			const int dy = (srcy < 0) ? srcy : (entry.height - r1.height());
+			r1.translate(0, dy);
+		}
+		if (flags & kWIFFlipX) {
+			const int dx = (srcx < 0) ? srcx : (entry.width - r1.width());
+			r1.translate(dx, 0);
+		}
+		if (xmapPtr) {
+			copyCachedWizImage<kWizXMap>(dst, dstPitch, dstType, entry, r1, flags, palPtr, xmapPtr, bitDepth);
+		} else if (palPtr) {
+			copyCachedWizImage<kWizRMap>(dst, dstPitch, dstType, entry, r1, flags, palPtr, NULL, bitDepth);
+		} else {
+			copyCachedWizImage<kWizCopy>(dst, dstPitch, dstType, entry, r1, flags, NULL, NULL, bitDepth);
+		}
+	}
+}
+
+template<int type>
+void Wiz::copyCachedWizImage(uint8 *dst, int dstPitch, int dstType, const WizCacheEntry &entry, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	int h = srcRect.height();
+	const int w = srcRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	if (flags & kWIFFlipY) {
+		dst += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	int dstInc = bitDepth;
+	if (flags & kWIFFlipX) {
+		dst += (w - 1) * bitDepth;
+		dstInc = -bitDepth;
+	}
+
+	const uint8 *src = entry.pixels + srcRect.top * entry.width + srcRect.left;
+	const uint8 *mask = entry.mask + srcRect.top * entry.width + srcRect.left;
+	while (h--) {
+		if (type == kWizCopy && dstInc == 1) {
+			for (int i = 0; i < w; ++i) {
+				if (mask[i])
+					dst[i] = src[i];
+			}
+		} else {
+			uint8 *dstPtr = dst;
+			for (int i = 0; i < w; ++i) {
+				if (mask[i])
+					write8BitColor<type>(dstPtr, src + i, dstType, palPtr, xmapPtr, bitDepth);
+				dstPtr += dstInc;
+			}
+		}
+		src += entry.width;
+		mask += entry.width;
+		dst += dstPitch;
+	}
+}
+
 static void decodeWizMask(uint8 *&dst, uint8 &mask, int w, int maskType) {
 	switch (maskType) {
 	case 0:
@@ -1408,6 +1577,7 @@ void Wiz::captureImage(uint8 *src, int srcPitch, int srcw, int srch, int resNum,
 			break;
 		}
 	}
+	invalidateWizCache(resNum);
 	_vm->_res->setModified(rtImage, resNum);
 }
 
@@ -1528,6 +1698,7 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 			getWizImageDim(dstResNum, 0, cw, ch);
 			dstPitch = cw * _vm->_bytesPerPixel;
 			dstType = kDstResource;
+			invalidateWizCache(dstResNum);
 		} else {
 			VirtScreen *pvs = &_vm->_virtscr[kMainVirtScreen];
 			if (flags & kWIFMarkBufferDirty) {
@@ -1582,7 +1753,12 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 			dstPitch /= _vm->_bytesPerPixel;
 			copyWizImageWithMask(dst, wizd, dstPitch, cw, ch, x1, y1, width, height, &rScreen, 0, 1);
 		} else {
-			copyWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
+			const WizCacheEntry *cached = getCachedWizImage(resNum, state, wizd, width, height);
+			if (cached) {
+				drawCachedWizImage(dst, dstPitch, dstType, cw, ch, x1, y1, *cached, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
+			} else {
+				copyWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
+			}
 		}
 		break;
 #ifdef USE_RGB_COLOR
@@ -1844,6 +2020,7 @@ void Wiz::drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int
 		getWizImageDim(dstResNum, 0, dstw, dsth);
 		dstpitch = dstw * _vm->_bytesPerPixel;
 		dstType = kDstResource;
+		invalidateWizCache(dstResNum);
 	} else {
 		if (flags & kWIFMarkBufferDirty) {
 			dst = pvs->getPixels(0, 0);
@@ -2172,6 +2349,7 @@ void Wiz::createWizEmptyImage(int resNum, int img_x, int img_y, int img_w, int i
 		WRITE_BE_UINT32(res_data, 'WIZD'); res_data += 4;
 		WRITE_BE_UINT32(res_data, 8 + img_w * img_h * bitDepth); res_data += 4;
 	}
+	invalidateWizCache(resNum);
 	_vm->_res->setModified(rtImage, resNum);
 }
 
@@ -2223,6 +2401,7 @@ void Wiz::fillWizRect(const WizParameters *params) {
 			}
 		}
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2292,6 +2471,7 @@ void Wiz::fillWizLine(const WizParameters *params) {
 			}
 		}
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2329,6 +2509,7 @@ void Wiz::fillWizPixel(const WizParameters *params) {
 			}
 		}
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2345,6 +2526,7 @@ void Wiz::remapWizImagePal(const WizParameters *params) {
 		uint8 idx = *index++;
 		rmap[4 + idx] = params->remapColor[idx];
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2386,6 +2568,7 @@ void Wiz::processWizImage(const WizParameters *params) {
 						_vm->VAR(_vm->VAR_GAME_LOADED) = -2;
 						_vm->VAR(119) = -2;
 					} else {
+						invalidateWizCache(params->img.resNum);
 						_vm->_res->setModified(rtImage, params->img.resNum);
 						_vm->VAR(_vm->VAR_GAME_LOADED) = 0;
 						_vm->VAR(119) = 0;
@@ -2496,6 +2679,7 @@ void Wiz::processWizImage(const WizParameters *params) {
 	case 17:
 		// Used in to draw circles in FreddisFunShop/PuttsFunShop/SamsFunShop
 		// TODO: Ellipse
+		invalidateWizCache(params->img.resNum);
 		_vm->_res->setModified(rtImage, params->img.resNum);
 		break;
 	default:
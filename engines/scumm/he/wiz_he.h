@@ -35,6 +35,22 @@ struct WizPolygon {
 	bool flag;
 };
 
+/**
+ * An RLE compressed (type 1) Wiz image state, decoded once so that it can be
+ * drawn with a plain masked blit. The colors are stored before any palette
+ * or XMAP is applied.
+ */
+struct WizCacheEntry {
+	int resNum;
+	int state;
+	const uint8 *wizd;	// the WIZD data the entry was decoded from
+	int width;
+	int height;
+	uint32 lastUsed;
+	uint8 *pixels;		// color of every pixel
+	uint8 *mask;		// 1 for opaque pixels, 0 for transparent ones
+};
+
 struct WizImage {
 	int resNum;
 	int x1;
@@ -160,6 +176,7 @@ public:
 	WizPolygon _polygons[NUM_POLYGONS];
 
 	Wiz(ScummEngine_v71he *vm);
+	~Wiz();
 
 	void clearWizBuffer();
 	Common::Rect _rectOverride;
@@ -192,6 +209,13 @@ public:
 
 	void flushWizBuffer();
 
+	void invalidateWizCache(int resNum);
+	void clearWizCache();
+	uint32 getWizCacheSize() const { return _cacheSize; }
+	uint32 getWizCacheHits() const { return _cacheHits; }
+	uint32 getWizCacheMisses() const { return _cacheMisses; }
+	uint32 getWizCacheEvictions() const { return _cacheEvictions; }
+
 	void getWizImageSpot(int resId, int state, int32 &x, int32 &y);
 	void loadWizCursor(int resId, int palette);
 
@@ -222,6 +246,7 @@ public:
 	template<int type> static void decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr = NULL);
 #endif
 	template<int type> static void decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitdepth);
+	template<int type> static void copyCachedWizImage(uint8 *dst, int dstPitch, int dstType, const WizCacheEntry &entry, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 	template<int type> static void decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, int srcPitch, int w, int h, int transColor, const uint8 *palPtr, uint8 bitdepth);
 
 #ifdef USE_RGB_COLOR
@@ -238,6 +263,22 @@ public:
 
 private:
 	ScummEngine_v71he *_vm;
+
+	enum {
+		kWizCacheEntries = 64,
+		kWizCacheBudget = 4 * 1024 * 1024
+	};
+
+	WizCacheEntry _cache[kWizCacheEntries];
+	uint32 _cacheSize;
+	uint32 _cacheClock;
+	uint32 _cacheHits;
+	uint32 _cacheMisses;
+	uint32 _cacheEvictions;
+
+	const WizCacheEntry *getCachedWizImage(int resNum, int state, const uint8 *wizd, int width, int height);
+	void freeWizCacheEntry(WizCacheEntry &entry);
+	void drawCachedWizImage(uint8 *dst, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const WizCacheEntry &entry, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 };
 
 } // End of namespace Scumm
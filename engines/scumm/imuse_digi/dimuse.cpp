@@ -39,7 +39,14 @@ namespace Scumm {
 
 void IMuseDigital::timer_handler(void *refCon) {
 	IMuseDigital *imuseDigital = (IMuseDigital *)refCon;
+
+	const uint32 start = g_system->getMillis();
 	imuseDigital->callback();
+	const uint32 time = g_system->getMillis() - start;
+
+	imuseDigital->_feedCount++;
+	imuseDigital->_feedTimeTotal += time;
+	imuseDigital->_feedTimeMax = MAX(imuseDigital->_feedTimeMax, time);
 }
 
 IMuseDigital::IMuseDigital(ScummEngine_v7 *scumm, Audio::Mixer *mixer, int fps)
@@ -51,6 +58,10 @@ IMuseDigital::IMuseDigital(ScummEngine_v7 *scumm, Audio::Mixer *mixer, int fps)
 	_sound = new ImuseDigiSndMgr(_vm);
 	assert(_sound);
 	_callbackFps = fps;
+	_feedCount = 0;
+	_feedTimeTotal = 0;
+	_feedTimeMax = 0;
+	_prefetchTimeTotal = 0;
 	resetState();
 	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
 		_track[l] = new Track;
@@ -363,6 +374,34 @@ void IMuseDigital::callback() {
 	}
 }
 
+void IMuseDigital::prefetch() {
+	Common::StackLock lock(_mutex, "IMuseDigital::prefetch()");
+
+	if (_pause)
+		return;
+
+	const uint32 start = g_system->getMillis();
+
+	// Decompress the data the next two callbacks will feed for every track
+	// playing from a bundle, so that callback() finds it in the block cache
+	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
+		Track *track = _track[l];
+		if (!track->used || !track->stream || track->souStreamUsed || track->curRegion == -1)
+			continue;
+
+		int32 offset = track->regionOffset;
+		int32 size = 2 * track->feedSize / _callbackFps;
+		if (_sound->getBits(track->soundDesc) == 12) {
+			offset = (offset * 3) / 4;
+			size = (size * 3) / 4;
+		}
+
+		_sound->prefetchRegion(track->soundDesc, track->curRegion, offset, size);
+	}
+
+	_prefetchTimeTotal += g_system->getMillis() - start;
+}
+
 void IMuseDigital::switchToNextRegion(Track *track) {
 	assert(track);
 
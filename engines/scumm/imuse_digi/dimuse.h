@@ -86,6 +86,12 @@ private:
 	int _stopingSequence;
 	bool _radioChatterSFX;
 
+	// Time spent in callback() and prefetch(), in milliseconds
+	uint32 _feedCount;
+	uint32 _feedTimeTotal;
+	uint32 _feedTimeMax;
+	uint32 _prefetchTimeTotal;
+
 	static void timer_handler(void *refConf);
 	void callback();
 	void switchToNextRegion(Track *track);
@@ -122,6 +128,13 @@ public:
 	IMuseDigital(ScummEngine_v7 *scumm, Audio::Mixer *mixer, int fps);
 	virtual ~IMuseDigital();
 
+	/**
+	 * Decompress the bundle blocks the next feeds will need. This is called
+	 * from the engine thread, so that the timer feed only has to copy
+	 * blocks that are already decompressed.
+	 */
+	void prefetch();
+
 	void setAudioNames(int32 num, char *names);
 
 	void startVoice(int soundId, Audio::AudioStream *input);
@@ -158,6 +171,12 @@ public:
 	int32 getCurVoiceLipSyncHeight();
 	int32 getCurMusicLipSyncWidth(int syncId);
 	int32 getCurMusicLipSyncHeight(int syncId);
+
+	uint32 getFeedCount() const { return _feedCount; }
+	uint32 getFeedTimeTotal() const { return _feedTimeTotal; }
+	uint32 getFeedTimeMax() const { return _feedTimeMax; }
+	uint32 getPrefetchTimeTotal() const { return _prefetchTimeTotal; }
+	const BundleDirCache *getBundleDirCache() const { return _sound->getBundleDirCache(); }
 };
 
 } // End of namespace Scumm
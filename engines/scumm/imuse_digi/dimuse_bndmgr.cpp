@@ -37,6 +37,20 @@ BundleDirCache::BundleDirCache() {
 		_budleDirCache[fileId].isCompressed = false;
 		_budleDirCache[fileId].indexTable = NULL;
 	}
+
+	_blockData = (byte *)malloc(kNumCachedBlocks * kBlockSize);
+	assert(_blockData);
+	for (int i = 0; i < kNumCachedBlocks; i++) {
+		_blocks[i].slot = -1;
+		_blocks[i].offset = 0;
+		_blocks[i].size = 0;
+		_blocks[i].lastUsed = 0;
+		_blocks[i].data = _blockData + i * kBlockSize;
+	}
+	_blockCounter = 0;
+	_blockHits = 0;
+	_blockMisses = 0;
+	_blocksPrefetched = 0;
 }
 
 BundleDirCache::~BundleDirCache() {
@@ -44,6 +58,47 @@ BundleDirCache::~BundleDirCache() {
 		free(_budleDirCache[fileId].bundleTable);
 		free(_budleDirCache[fileId].indexTable);
 	}
+	free(_blockData);
+}
+
+BundleDirCache::DecompressedBlock *BundleDirCache::findBlock(int slot, int32 offset) {
+	for (int i = 0; i < kNumCachedBlocks; i++) {
+		if (_blocks[i].slot == slot && _blocks[i].offset == offset) {
+			_blocks[i].lastUsed = ++_blockCounter;
+			_blockHits++;
+			return &_blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool BundleDirCache::isBlockCached(int slot, int32 offset) const {
+	for (int i = 0; i < kNumCachedBlocks; i++) {
+		if (_blocks[i].slot == slot && _blocks[i].offset == offset)
+			return true;
+	}
+
+	return false;
+}
+
+BundleDirCache::DecompressedBlock *BundleDirCache::allocBlock(int slot, int32 offset, bool prefetch) {
+	DecompressedBlock *block = &_blocks[0];
+	for (int i = 1; i < kNumCachedBlocks && block->slot != -1; i++) {
+		if (_blocks[i].slot == -1 || _blocks[i].lastUsed < block->lastUsed)
+			block = &_blocks[i];
+	}
+
+	if (prefetch)
+		_blocksPrefetched++;
+	else
+		_blockMisses++;
+
+	block->slot = slot;
+	block->offset = offset;
+	block->size = 0;
+	block->lastUsed = ++_blockCounter;
+	return block;
 }
 
 BundleDirCache::AudioTable *BundleDirCache::getTable(int slot) {
@@ -145,6 +200,7 @@ BundleMgr::BundleMgr(BundleDirCache *cache) {
 	_numFiles = 0;
 	_numCompItems = 0;
 	_curSampleId = -1;
+	_slot = -1;
 	_fileBundleId = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
@@ -185,6 +241,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_slot = slot;
 	compressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -245,6 +302,18 @@ bool BundleMgr::loadCompTable(int32 index) {
 	return true;
 }
 
+int32 BundleMgr::decompressBlock(int32 index, int block, byte *output) {
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[block].size);
+	int32 outputSize = BundleCodecs::decompressCodec(_compTable[block].codec, _compInputBuff, output, _compTable[block].size);
+	if (outputSize > BundleDirCache::kBlockSize) {
+		error("_outputSize: %d", outputSize);
+	}
+	return outputSize;
+}
+
 int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside) {
 	return decompressSampleByIndex(_curSampleId, offset, size, compFinal, headerSize, headerOutside);
 }
@@ -271,29 +340,32 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 			return 0;
 	}
 
-	firstBlock = (offset + headerSize) / 0x2000;
-	lastBlock = (offset + headerSize + size - 1) / 0x2000;
+	firstBlock = (offset + headerSize) / BundleDirCache::kBlockSize;
+	lastBlock = (offset + headerSize + size - 1) / BundleDirCache::kBlockSize;
 
 	// Clip last_block by the total number of blocks (= "comp items")
 	if ((lastBlock >= _numCompItems) && (_numCompItems > 0))
 		lastBlock = _numCompItems - 1;
 
-	int32 blocksFinalSize = 0x2000 * (1 + lastBlock - firstBlock);
+	int32 blocksFinalSize = BundleDirCache::kBlockSize * (1 + lastBlock - firstBlock);
 	*compFinal = (byte *)malloc(blocksFinalSize);
 	assert(*compFinal);
 	finalSize = 0;
 
-	skip = (offset + headerSize) % 0x2000;
+	skip = (offset + headerSize) % BundleDirCache::kBlockSize;
 
 	for (i = firstBlock; i <= lastBlock; i++) {
 		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
+			const int32 blockOffset = _bundleTable[index].offset + _compTable[i].offset;
+			BundleDirCache::DecompressedBlock *block = _cache->findBlock(_slot, blockOffset);
+			if (block) {
+				_outputSize = block->size;
+				memcpy(_compOutputBuff, block->data, _outputSize);
+			} else {
+				_outputSize = decompressBlock(index, i, _compOutputBuff);
+				block = _cache->allocBlock(_slot, blockOffset, false);
+				block->size = _outputSize;
+				memcpy(block->data, _compOutputBuff, _outputSize);
 			}
 			_lastBlock = i;
 		}
@@ -307,8 +379,8 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 				outputSize -= skip;
 		}
 
-		if ((outputSize + skip) > 0x2000) // workaround
-			outputSize -= (outputSize + skip) - 0x2000;
+		if ((outputSize + skip) > BundleDirCache::kBlockSize) // workaround
+			outputSize -= (outputSize + skip) - BundleDirCache::kBlockSize;
 
 		if (outputSize > size)
 			outputSize = size;
@@ -329,6 +401,26 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 	return finalSize;
 }
 
+void BundleMgr::prefetchByCurIndex(int32 offset, int32 size, int headerSize) {
+	// Nothing is known about the sample before it was first read from
+	if (!_file->isOpen() || _curSampleId == -1 || !_compTableLoaded || size <= 0)
+		return;
+
+	int firstBlock = (offset + headerSize) / BundleDirCache::kBlockSize;
+	int lastBlock = (offset + headerSize + size - 1) / BundleDirCache::kBlockSize;
+	if (lastBlock >= _numCompItems)
+		lastBlock = _numCompItems - 1;
+
+	for (int i = firstBlock; i <= lastBlock; i++) {
+		const int32 blockOffset = _bundleTable[_curSampleId].offset + _compTable[i].offset;
+		if (i == _lastBlock || _cache->isBlockCached(_slot, blockOffset))
+			continue;
+
+		BundleDirCache::DecompressedBlock *block = _cache->allocBlock(_slot, blockOffset, true);
+		block->size = decompressBlock(_curSampleId, i, block->data);
+	}
+}
+
 int32 BundleMgr::decompressSampleByName(const char *name, int32 offset, int32 size, byte **comp_final, bool header_outside) {
 	int32 final_size = 0;
 
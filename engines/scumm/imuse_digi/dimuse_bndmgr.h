@@ -42,6 +42,23 @@ public:
 		int32 index;
 	};
 
+	enum {
+		kBlockSize = 0x2000,
+		kNumCachedBlocks = 32
+	};
+
+	/**
+	 * A decompressed block of a bundle. Blocks are identified by the slot of
+	 * their bundle and the offset of their compressed data in it.
+	 */
+	struct DecompressedBlock {
+		int slot;			// -1 if the entry is unused
+		int32 offset;
+		int32 size;
+		uint32 lastUsed;
+		byte *data;
+	};
+
 private:
 
 	struct FileDirCache {
@@ -52,6 +69,16 @@ private:
 		IndexNode *indexTable;
 	} _budleDirCache[4];
 
+	// Decompressed blocks shared by all bundles, the least recently used
+	// block is replaced first
+	DecompressedBlock _blocks[kNumCachedBlocks];
+	byte *_blockData;
+	uint32 _blockCounter;
+
+	uint32 _blockHits;
+	uint32 _blockMisses;
+	uint32 _blocksPrefetched;
+
 public:
 	BundleDirCache();
 	~BundleDirCache();
@@ -61,6 +88,22 @@ public:
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
+
+	/**
+	 * Look up a decompressed block. Returns NULL if it is not cached.
+	 */
+	DecompressedBlock *findBlock(int slot, int32 offset);
+	bool isBlockCached(int slot, int32 offset) const;
+
+	/**
+	 * Get an entry to store a decompressed block in. The caller has to fill
+	 * in its data and size.
+	 */
+	DecompressedBlock *allocBlock(int slot, int32 offset, bool prefetch);
+
+	uint32 getBlockHits() const { return _blockHits; }
+	uint32 getBlockMisses() const { return _blockMisses; }
+	uint32 getBlocksPrefetched() const { return _blocksPrefetched; }
 };
 
 class BundleMgr {
@@ -81,15 +124,17 @@ private:
 	int _numFiles;
 	int _numCompItems;
 	int _curSampleId;
+	int _slot;
 	BaseScummFile *_file;
 	bool _compTableLoaded;
 	int _fileBundleId;
-	byte _compOutputBuff[0x2000];
+	byte _compOutputBuff[BundleDirCache::kBlockSize];
 	byte *_compInputBuff;
 	int _outputSize;
 	int _lastBlock;
 
 	bool loadCompTable(int32 index);
+	int32 decompressBlock(int32 index, int block, byte *output);
 
 public:
 
@@ -102,6 +147,12 @@ public:
 	int32 decompressSampleByName(const char *name, int32 offset, int32 size, byte **compFinal, bool headerOutside);
 	int32 decompressSampleByIndex(int32 index, int32 offset, int32 size, byte **compFinal, int header_size, bool headerOutside);
 	int32 decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside);
+
+	/**
+	 * Decompress the blocks of the current sample needed for the given
+	 * range ahead of time, so that reading it later on is only a copy.
+	 */
+	void prefetchByCurIndex(int32 offset, int32 size, int headerSize);
 };
 
 } // End of namespace Scumm
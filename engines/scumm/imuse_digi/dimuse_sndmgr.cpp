@@ -632,6 +632,24 @@ int ImuseDigiSndMgr::getJumpFade(SoundDesc *soundDesc, int number) {
 	return soundDesc->jump[number].fadeDelay;
 }
 
+void ImuseDigiSndMgr::prefetchRegion(SoundDesc *soundDesc, int region, int32 offset, int32 size) {
+	assert(checkForProperHandle(soundDesc));
+	assert(region >= 0 && region < soundDesc->numRegions);
+
+	if (!soundDesc->bundle || soundDesc->compressed)
+		return;
+
+	int32 region_offset = soundDesc->region[region].offset;
+	int32 region_length = soundDesc->region[region].length;
+	int32 offset_data = soundDesc->offsetData;
+	int32 start = region_offset - offset_data;
+
+	if (offset + size + offset_data > region_length)
+		size = region_length - offset;
+
+	soundDesc->bundle->prefetchByCurIndex(start + offset, size, soundDesc->offsetData);
+}
+
 int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size) {
 	debug(6, "getDataFromRegion() region:%d, offset:%d, size:%d, numRegions:%d", region, offset, size, soundDesc->numRegions);
 	assert(checkForProperHandle(soundDesc));
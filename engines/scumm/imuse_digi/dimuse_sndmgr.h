@@ -146,6 +146,14 @@ public:
 	void getSyncSizeAndPtrById(SoundDesc *soundDesc, int number, int32 &sync_size, byte **sync_ptr);
 
 	int32 getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size);
+
+	/**
+	 * Prepare the data getDataFromRegion() will return for the given range
+	 * in advance. Only uncompressed bundles benefit from this.
+	 */
+	void prefetchRegion(SoundDesc *soundDesc, int region, int32 offset, int32 size);
+
+	const BundleDirCache *getBundleDirCache() const { return _cacheBundleDir; }
 };
 
 } // End of namespace Scumm
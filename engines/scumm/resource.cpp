@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/str.h"
 #ifndef MACOSX
 #include "common/config-manager.h"
@@ -44,8 +45,7 @@ namespace Scumm {
 
 enum {
 	RF_LOCK = 0x80,
-	RF_USAGE = 0x7F,
-	RF_USAGE_MAX = RF_USAGE,
+	RF_USAGE_MAX = 0x7F,
 
 	RS_MODIFIED = 0x10,
 	RF_OFFHEAP = 0x40
@@ -540,6 +540,10 @@ void ResourceManager::allocResTypeData(ResType type, uint32 tag, int num, ResTyp
 
 	// If there was data in there, let's clear it out completely. This is important
 	// in case we are restarting the game.
+	for (uint i = _loadedResources.size(); i-- > 0; ) {
+		if (_loadedResources[i].type == type)
+			removeLoadedResource(type, _loadedResources[i].idx);
+	}
 	_types[type].clear();
 	_types[type].resize(num);
 
@@ -777,28 +781,34 @@ void ResourceManager::increaseExpireCounter() {
 }
 
 void ResourceManager::increaseResourceCounters() {
-	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-		ResId idx = _types[type].size();
-		while (idx-- > 0) {
-			byte counter = _types[type][idx].getResourceCounter();
-			if (counter && counter < RF_USAGE_MAX) {
-				setResourceCounter(type, idx, counter + 1);
-			}
-		}
-	}
+	// The counters of all resources are derived from the generation, so
+	// this ages every loaded resource without touching any of them.
+	++_generation;
 }
 
 void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
-	_types[type][idx].setResourceCounter(counter);
+	_types[type][idx].setResourceCounter(counter, _generation);
+}
+
+byte ResourceManager::getResourceCounter(ResType type, ResId idx) const {
+	return _types[type][idx].getResourceCounter(_generation);
 }
 
-void ResourceManager::Resource::setResourceCounter(byte counter) {
-	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
-	_flags |= counter;	// Update the usage counter
+void ResourceManager::Resource::setResourceCounter(byte counter, uint32 generation) {
+	_counter = counter & RF_USAGE_MAX;
+	_generation = generation;
 }
 
-byte ResourceManager::Resource::getResourceCounter() const {
-	return _flags & RF_USAGE;
+byte ResourceManager::Resource::getResourceCounter(uint32 generation) const {
+	// A counter of 0 marks a resource which is not in use at all, and
+	// does not age
+	if (!_counter)
+		return 0;
+
+	const uint32 age = generation - _generation;
+	if (age >= (uint32)(RF_USAGE_MAX - _counter))
+		return RF_USAGE_MAX;
+	return _counter + age;
 }
 
 /* 2 bytes safety area to make "precaching" of bytes in the gdi drawer easier */
@@ -830,10 +840,15 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	memset(ptr, 0, size + SAFETY_AREA);
 	_allocatedSize += size;
+	_numAllocations++;
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
 	setResourceCounter(type, idx, 1);
+
+	if (_types[type]._mode != kDynamicResTypeMode)
+		addLoadedResource(type, idx);
+
 	return ptr;
 }
 
@@ -841,6 +856,9 @@ ResourceManager::Resource::Resource() {
 	_address = 0;
 	_size = 0;
 	_flags = 0;
+	_counter = 0;
+	_generation = 0;
+	_loadedIndex = -1;
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
@@ -856,6 +874,7 @@ void ResourceManager::Resource::nuke() {
 	_address = 0;
 	_size = 0;
 	_flags = 0;
+	_counter = 0;
 	_status &= ~RS_MODIFIED;
 }
 
@@ -872,6 +891,9 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_generation = 0;
+	_numAllocations = 0;
+	_numEvictions = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -898,10 +920,37 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
+		removeLoadedResource(type, idx);
 		_types[type][idx].nuke();
 	}
 }
 
+void ResourceManager::addLoadedResource(ResType type, ResId idx) {
+	Resource &res = _types[type][idx];
+	if (res._loadedIndex >= 0)
+		return;
+
+	LoadedResource loaded;
+	loaded.type = type;
+	loaded.idx = idx;
+	res._loadedIndex = _loadedResources.size();
+	_loadedResources.push_back(loaded);
+}
+
+void ResourceManager::removeLoadedResource(ResType type, ResId idx) {
+	Resource &res = _types[type][idx];
+	if (res._loadedIndex < 0)
+		return;
+
+	// Move the last entry into the freed up slot
+	const LoadedResource &last = _loadedResources.back();
+	_types[last.type][last.idx]._loadedIndex = res._loadedIndex;
+	_loadedResources[res._loadedIndex] = last;
+	_loadedResources.pop_back();
+
+	res._loadedIndex = -1;
+}
+
 const byte *ScummEngine::findResourceData(uint32 tag, const byte *ptr) {
 	if (_game.features & GF_OLD_BUNDLE)
 		error("findResourceData must not be used in GF_OLD_BUNDLE games");
@@ -1032,10 +1081,31 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+namespace {
+
+struct ExpireCandidate {
+	ResType type;
+	ResId idx;
+	byte counter;
+	uint32 size;
+};
+
+/**
+ * Orders resources by how much they should be thrown out: the oldest ones
+ * first, and of equally old ones the largest, so that as few resources as
+ * possible have to be reloaded later on.
+ */
+struct ExpireCandidateOrder {
+	bool operator()(const ExpireCandidate &a, const ExpireCandidate &b) const {
+		if (a.counter != b.counter)
+			return a.counter > b.counter;
+		return a.size > b.size;
+	}
+};
+
+} // End of anonymous namespace
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1048,30 +1118,36 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
-			}
+	// Only resources which can be reloaded from the data files are in
+	// _loadedResources, so we can potentially unload those to free memory.
+	Common::Array<ExpireCandidate> candidates;
+	candidates.reserve(_loadedResources.size());
+
+	for (uint i = 0; i < _loadedResources.size(); i++) {
+		const ResType type = _loadedResources[i].type;
+		const ResId idx = _loadedResources[i].idx;
+		const Resource &tmp = _types[type][idx];
+
+		ExpireCandidate candidate;
+		candidate.counter = tmp.getResourceCounter(_generation);
+
+		if (!tmp.isLocked() && candidate.counter >= 2 && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+			candidate.type = type;
+			candidate.idx = idx;
+			candidate.size = tmp._size;
+			candidates.push_back(candidate);
 		}
+	}
 
-		if (!best_type)
+	Common::sort(candidates.begin(), candidates.end(), ExpireCandidateOrder());
+
+	uint next = 0;
+	do {
+		if (next == candidates.size())
 			break;
-		nukeResource(best_type, best_res);
+		nukeResource(candidates[next].type, candidates[next].idx);
+		_numEvictions++;
+		next++;
 	} while (size + _allocatedSize > _minHeapThreshold);
 
 	increaseResourceCounters();
@@ -1088,6 +1164,7 @@ void ResourceManager::freeResources() {
 		}
 		_types[type].clear();
 	}
+	_loadedResources.clear();
 }
 
 void ScummEngine::loadPtrToResource(ResType type, ResId idx, const byte *source) {
@@ -1134,6 +1211,7 @@ void ResourceManager::resourceStats() {
 	}
 
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
+	debug(1, "Allocations=%d, evictions=%d, generation=%d", _numAllocations, _numEvictions, _generation);
 }
 
 void ScummEngine_v5::readMAXS(int blockSize) {
@@ -80,6 +80,7 @@ protected:
 
 public:
 	class Resource {
+	friend class ResourceManager;
 	public:
 		/**
 		 * Pointer to the data contained in this resource
@@ -94,15 +95,34 @@ public:
 	protected:
 		/**
 		 * The uppermost bit indicates whether the resources is locked.
-		 * The lower 7 bits contain a counter. This counter measures roughly
-		 * how old the resource is; it starts out with a count of 1 and can go
-		 * as high as 127. When memory falls low resp. when the engine decides
-		 * that it should throw out some unused stuff, then it begins by
-		 * removing the resources with the highest counter (excluding locked
-		 * resources and resources that are known to be in use).
 		 */
 		byte _flags;
 
+		/**
+		 * The usage counter. This counter measures roughly how old the
+		 * resource is; it starts out with a count of 1 and can go as high as
+		 * 127. When memory falls low resp. when the engine decides that it
+		 * should throw out some unused stuff, then it begins by removing the
+		 * resources with the highest counter (excluding locked resources and
+		 * resources that are known to be in use).
+		 *
+		 * Only the value the counter was last set to is stored here. The
+		 * current value is derived from the number of generations that
+		 * passed since then, see ResourceManager::_generation.
+		 */
+		byte _counter;
+
+		/**
+		 * The generation of the resource manager when _counter was set.
+		 */
+		uint32 _generation;
+
+		/**
+		 * The position of this resource in ResourceManager::_loadedResources,
+		 * or -1 if it is not in there.
+		 */
+		int _loadedIndex;
+
 		/**
 		 * The status of the resource. Currently only one bit is used, which
 		 * indicates whether the resource is modified.
@@ -131,8 +151,8 @@ public:
 
 		void nuke();
 
-		inline void setResourceCounter(byte counter);
-		inline byte getResourceCounter() const;
+		inline void setResourceCounter(byte counter, uint32 generation);
+		inline byte getResourceCounter(uint32 generation) const;
 
 		void lock();
 		void unlock();
@@ -175,6 +195,27 @@ protected:
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
+	/**
+	 * The current generation. Every call to increaseResourceCounters() starts
+	 * a new generation, which ages all loaded resources by one at once.
+	 */
+	uint32 _generation;
+
+	struct LoadedResource {
+		ResType type;
+		ResId idx;
+	};
+
+	/**
+	 * All loaded resources which can be reloaded from the game data files,
+	 * i.e. the ones expireResources() may throw out.
+	 */
+	Common::Array<LoadedResource> _loadedResources;
+
+	// Statistics, shown by the debugger
+	uint32 _numAllocations;
+	uint32 _numEvictions;
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
@@ -215,8 +256,13 @@ public:
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
 	/**
-	 * Increment the counter of all unlocked loaded resources.
-	 * The maximal count is 255.
+	 * Get the specified resource's counter.
+	 */
+	byte getResourceCounter(ResType type, ResId idx) const;
+
+	/**
+	 * Increment the counter of all loaded resources.
+	 * The maximal count is 127.
 	 * This is called by increaseExpireCounter and expireResources,
 	 * but also by ScummEngine::startScene.
 	 */
@@ -224,10 +270,18 @@ public:
 
 	void resourceStats();
 
+	uint32 getAllocatedSize() const { return _allocatedSize; }
+	uint32 getNumAllocations() const { return _numAllocations; }
+	uint32 getNumEvictions() const { return _numEvictions; }
+	uint32 getGeneration() const { return _generation; }
+
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	void addLoadedResource(ResType type, ResId idx);
+	void removeLoadedResource(ResType type, ResId idx);
 };
 
 } // End of namespace Scumm
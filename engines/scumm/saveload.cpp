@@ -1629,6 +1629,10 @@ void ScummEngine_v70he::saveOrLoad(Serializer *s) {
 void ScummEngine_v71he::saveOrLoad(Serializer *s) {
 	ScummEngine_v70he::saveOrLoad(s);
 
+	// Loading replaces the modified images, possibly at the same addresses
+	if (s->isLoading())
+		_wiz->clearWizCache();
+
 	const SaveLoadEntry polygonEntries[] = {
 		MKLINE(WizPolygon, vert[0].x, sleInt16, VER(40)),
 		MKLINE(WizPolygon, vert[0].y, sleInt16, VER(40)),
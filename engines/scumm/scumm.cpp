@@ -2437,6 +2437,7 @@ void ScummEngine_v7::scummLoop_handleSound() {
 	ScummEngine_v6::scummLoop_handleSound();
 	if (_imuseDigital) {
 		_imuseDigital->flushTracks();
+		_imuseDigital->prefetch();
 		// In CoMI and the Dig the full (non-demo) version invoke IMuseDigital::refreshScripts
 		if ((_game.id == GID_DIG || _game.id == GID_CMI) && !(_game.features & GF_DEMO))
 			_imuseDigital->refreshScripts();
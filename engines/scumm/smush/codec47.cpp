@@ -56,6 +56,8 @@ namespace Scumm {
 
 #endif
 
+#if defined(SCUMM_NEED_ALIGNMENT)
+
 #define FILL_4X1_LINE(dst, val)			\
 	do {					\
 		(dst)[0] = val;	\
@@ -64,12 +66,75 @@ namespace Scumm {
 		(dst)[3] = val;	\
 	} while (0)
 
+#else /* SCUMM_NEED_ALIGNMENT */
+
+#define FILL_4X1_LINE(dst, val)			\
+	*(uint32 *)(dst) = 0x01010101 * (byte)(val)
+
+#endif
+
 #define FILL_2X1_LINE(dst, val)			\
 	do {					\
 		(dst)[0] = val;	\
 		(dst)[1] = val;	\
 	} while (0)
 
+// The 8x8 blocks are copied and filled a whole row at a time. SSE2 is always
+// available on x86-64 and NEON on ARM64; both allow unaligned rows.
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+#define DECLARE_FILL_8X1(v, val)		\
+	const __m128i v = _mm_set1_epi8((char)(val))
+
+#define COPY_8X1_LINE(dst, src)			\
+	_mm_storel_epi64((__m128i *)(dst), _mm_loadl_epi64((const __m128i *)(src)))
+
+#define FILL_8X1_LINE(dst, v)			\
+	_mm_storel_epi64((__m128i *)(dst), v)
+
+#define BLEND_8X1_LINE(dst, mask, v1, v2)	\
+	do {					\
+		const __m128i m = _mm_loadl_epi64((const __m128i *)(mask));	\
+		_mm_storel_epi64((__m128i *)(dst), _mm_or_si128(_mm_and_si128(m, v1), _mm_andnot_si128(m, v2)));	\
+	} while (0)
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h>
+
+#define DECLARE_FILL_8X1(v, val)		\
+	const uint8x8_t v = vdup_n_u8(val)
+
+#define COPY_8X1_LINE(dst, src)			\
+	vst1_u8((dst), vld1_u8(src))
+
+#define FILL_8X1_LINE(dst, v)			\
+	vst1_u8((dst), v)
+
+#define BLEND_8X1_LINE(dst, mask, v1, v2)	\
+	vst1_u8((dst), vbsl_u8(vld1_u8(mask), v1, v2))
+
+#else
+
+#define DECLARE_FILL_8X1(v, val)		\
+	const byte v = (val)
+
+#define COPY_8X1_LINE(dst, src)			\
+	do {					\
+		COPY_4X1_LINE((dst) + 0, (src) + 0);	\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
+#define FILL_8X1_LINE(dst, v)			\
+	do {					\
+		FILL_4X1_LINE((dst) + 0, v);	\
+		FILL_4X1_LINE((dst) + 4, v);	\
+	} while (0)
+
+#endif
+
 static const  int8 codec47_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -263,6 +328,8 @@ void Codec47Decoder::makeTablesInterpolation(int param) {
 			}
 
 			if (param == 8) {
+				for (i = 0; i < 64; i++)
+					_tableBigMasks[s / 388][i] = tableSmallBig[i] ? 0xFF : 0;
 				for (i = 64 - 1; i >= 0; i--) {
 					if (tableSmallBig[i] != 0) {
 						_tableBig[256 + s + _tableBig[384 + s]] = (byte)i;
@@ -451,8 +518,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -464,14 +530,24 @@ void Codec47Decoder::level1(byte *d_dst) {
 		d_dst += 4;
 		level2(d_dst);
 	} else if (code == 0xFE) {
-		byte t = *_d_src++;
+		DECLARE_FILL_8X1(t, *_d_src++);
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
 		tmp = *_d_src++;
+#ifdef BLEND_8X1_LINE
+		const byte *mask = _tableBigMasks[tmp];
+		DECLARE_FILL_8X1(v1, _d_src[0]);
+		DECLARE_FILL_8X1(v2, _d_src[1]);
+		_d_src += 2;
+		for (i = 0; i < 8; i++) {
+			BLEND_8X1_LINE(d_dst, mask, v1, v2);
+			mask += 8;
+			d_dst += _d_pitch;
+		}
+#else
 		byte *tmp_ptr = _tableBig + tmp * 388;
 		byte l = tmp_ptr[384];
 		byte val = *_d_src++;
@@ -487,18 +563,17 @@ void Codec47Decoder::level1(byte *d_dst) {
 			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
 			tmp_ptr2++;
 		}
+#endif
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
-		byte t = _paramPtr[code];
+		DECLARE_FILL_8X1(t, _paramPtr[code]);
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -41,6 +41,9 @@ private:
 	int32 _offset1, _offset2;
 	byte *_tableBig;
 	byte *_tableSmall;
+	// The pixels of each _tableBig glyph taking the first color, one byte
+	// per pixel (0xFF or 0) in row order
+	byte _tableBigMasks[256][64];
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
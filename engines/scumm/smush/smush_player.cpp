@@ -222,6 +222,10 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm) {
 	_base = NULL;
 	_frameBuffer = NULL;
 	_specialBuffer = NULL;
+	_nextFrame = NULL;
+	_nextFramePos = -1;
+	_nextFobj = NULL;
+	_nextFobjPos = -1;
 
 	_seekPos = -1;
 
@@ -287,6 +291,8 @@ void SmushPlayer::release() {
 	delete _strings;
 	_strings = NULL;
 
+	discardReadAhead();
+
 	delete _base;
 	_base = NULL;
 
@@ -780,16 +786,14 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 		return;
 	}
 
-	int32 chunkSize = subSize;
-	byte *chunkBuffer = (byte *)malloc(chunkSize);
-	assert(chunkBuffer);
-	b.read(chunkBuffer, chunkSize);
-
-	unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
-	byte *fobjBuffer = (byte *)malloc(decompressedSize);
-	if (!Common::uncompress(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
-		error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
-	free(chunkBuffer);
+	byte *fobjBuffer;
+	if (_nextFobj && &b == _nextFrame && b.pos() == _nextFobjPos) {
+		// Inflated by readAheadFrame()
+		fobjBuffer = _nextFobj;
+		_nextFobj = NULL;
+	} else {
+		fobjBuffer = inflateFrameObject(subSize, b);
+	}
 
 	byte *ptr = fobjBuffer;
 	int codec = READ_LE_UINT16(ptr); ptr += 2;
@@ -802,6 +806,21 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 
 	free(fobjBuffer);
 }
+
+byte *SmushPlayer::inflateFrameObject(int32 subSize, Common::SeekableReadStream &b) {
+	int32 chunkSize = subSize;
+	byte *chunkBuffer = (byte *)malloc(chunkSize);
+	assert(chunkBuffer);
+	b.read(chunkBuffer, chunkSize);
+
+	unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
+	byte *fobjBuffer = (byte *)malloc(decompressedSize);
+	if (!Common::uncompress(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
+		error("SmushPlayer::inflateFrameObject() Zlib uncompress error");
+	free(chunkBuffer);
+
+	return fobjBuffer;
+}
 #endif
 
 void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b) {
@@ -1004,6 +1023,7 @@ void SmushPlayer::parseNextFrame() {
 			_skipPalette = true;
 		}
 
+		discardReadAhead();
 		_base->seek(_seekPos + 8, SEEK_SET);
 		_frame = _seekFrame;
 		_startFrame = _frame;
@@ -1014,30 +1034,44 @@ void SmushPlayer::parseNextFrame() {
 
 	assert(_base);
 
-	const uint32 subType = _base->readUint32BE();
-	const int32 subSize = _base->readUint32BE();
-	const int32 subOffset = _base->pos();
+	if (_nextFrame && _base->pos() != _nextFramePos)
+		discardReadAhead();
 
-	if (_base->pos() >= (int32)_baseSize) {
-		_vm->_smushVideoShouldFinish = true;
-		_endOfFile = true;
-		return;
-	}
+	if (_nextFrame) {
+		const int32 subSize = _nextFrame->size();
+		const int32 subOffset = _nextFramePos + 8;
 
-	debug(3, "Chunk: %s at %x", tag2str(subType), subOffset);
+		debug(3, "Chunk: FRME at %x (read ahead)", subOffset);
 
-	switch (subType) {
-	case MKTAG('A','H','D','R'): // FT INSANE may seek file to the beginning
-		handleAnimHeader(subSize, *_base);
-		break;
-	case MKTAG('F','R','M','E'):
-		handleFrame(subSize, *_base);
-		break;
-	default:
-		error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
-	}
+		_base->seek(subOffset + subSize, SEEK_SET);
+		handleFrame(subSize, *_nextFrame);
+		discardReadAhead();
+	} else {
+		const uint32 subType = _base->readUint32BE();
+		const int32 subSize = _base->readUint32BE();
+		const int32 subOffset = _base->pos();
+
+		if (_base->pos() >= (int32)_baseSize) {
+			_vm->_smushVideoShouldFinish = true;
+			_endOfFile = true;
+			return;
+		}
+
+		debug(3, "Chunk: %s at %x", tag2str(subType), subOffset);
+
+		switch (subType) {
+		case MKTAG('A','H','D','R'): // FT INSANE may seek file to the beginning
+			handleAnimHeader(subSize, *_base);
+			break;
+		case MKTAG('F','R','M','E'):
+			handleFrame(subSize, *_base);
+			break;
+		default:
+			error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
+		}
 
-	_base->seek(subOffset + subSize, SEEK_SET);
+		_base->seek(subOffset + subSize, SEEK_SET);
+	}
 
 	if (_insanity)
 		_vm->_sound->processSound();
@@ -1045,6 +1079,54 @@ void SmushPlayer::parseNextFrame() {
 	_vm->_imuseDigital->flushTracks();
 }
 
+void SmushPlayer::readAheadFrame() {
+	// Reading and inflating the next frame is done while the player would
+	// otherwise just wait for it to become due, so that parseNextFrame()
+	// only has to decode it.
+	if (!_base || _nextFrame || _seekPos >= 0 || _endOfFile)
+		return;
+
+	const int32 pos = _base->pos();
+	if (pos + 8 >= (int32)_baseSize)
+		return;
+
+	const uint32 subType = _base->readUint32BE();
+	const int32 subSize = _base->readUint32BE();
+	if (subType == MKTAG('F','R','M','E') && subSize > 0 && pos + 8 + subSize <= (int32)_baseSize) {
+		_nextFrame = _base->readStream(subSize);
+		_nextFramePos = pos;
+	}
+	_base->seek(pos, SEEK_SET);
+
+#ifdef USE_ZLIB
+	if (!_nextFrame)
+		return;
+
+	while (_nextFrame->pos() + 8 <= _nextFrame->size()) {
+		const uint32 objType = _nextFrame->readUint32BE();
+		const int32 objSize = _nextFrame->readUint32BE();
+		const int32 objOffset = _nextFrame->pos();
+		if (objType == MKTAG('Z','F','O','B')) {
+			_nextFobj = inflateFrameObject(objSize, *_nextFrame);
+			_nextFobjPos = objOffset;
+			break;
+		}
+		_nextFrame->seek(objOffset + objSize + (objSize & 1), SEEK_SET);
+	}
+	_nextFrame->seek(0, SEEK_SET);
+#endif
+}
+
+void SmushPlayer::discardReadAhead() {
+	delete _nextFrame;
+	_nextFrame = NULL;
+	_nextFramePos = -1;
+
+	free(_nextFobj);
+	_nextFobj = NULL;
+	_nextFobjPos = -1;
+}
+
 void SmushPlayer::setPalette(const byte *palette) {
 	memcpy(_pal, palette, 0x300);
 	setDirtyColors(0, 255);
@@ -1249,6 +1331,7 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 			_IACTpos = 0;
 			break;
 		}
+		readAheadFrame();
 		_vm->_system->delayMillis(10);
 	}
 
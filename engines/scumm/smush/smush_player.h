@@ -82,6 +82,14 @@ private:
 	bool _middleAudio;
 	bool _skipPalette;
 
+	// The FRME chunk following the current position of _base, read while
+	// the player waits for the next frame, and its first ZFOB object
+	// inflated in advance
+	Common::SeekableReadStream *_nextFrame;
+	int32 _nextFramePos;
+	byte *_nextFobj;
+	int32 _nextFobjPos;
+
 public:
 	SmushPlayer(ScummEngine_v7 *scumm);
 	~SmushPlayer();
@@ -111,6 +119,8 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void readAheadFrame();
+	void discardReadAhead();
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
@@ -123,6 +133,7 @@ private:
 	void handleNewPalette(int32 subSize, Common::SeekableReadStream &);
 #ifdef USE_ZLIB
 	void handleZlibFrameObject(int32 subSize, Common::SeekableReadStream &b);
+	byte *inflateFrameObject(int32 subSize, Common::SeekableReadStream &b);
 #endif
 	void handleFrameObject(int32 subSize, Common::SeekableReadStream &);
 	void handleSoundBuffer(int32, int32, int32, int32, int32, int32, Common::SeekableReadStream &, int32);
@@ -23,6 +23,8 @@
 #include "tinsel/tinsel.h"
 #include "tinsel/debugger.h"
 #include "tinsel/dialogs.h"
+#include "tinsel/handle.h"
+#include "tinsel/heapmem.h"
 #include "tinsel/pcode.h"
 #include "tinsel/scene.h"
 #include "tinsel/sound.h"
@@ -67,6 +69,7 @@ Console::Console() : GUI::Debugger() {
 	DCmd_Register("music",		WRAP_METHOD(Console, cmd_music));
 	DCmd_Register("sound",		WRAP_METHOD(Console, cmd_sound));
 	DCmd_Register("string",		WRAP_METHOD(Console, cmd_string));
+	DCmd_Register("memory",		WRAP_METHOD(Console, cmd_memory));
 }
 
 Console::~Console() {
@@ -161,4 +164,15 @@ bool Console::cmd_string(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmd_memory(int argc, const char **argv) {
+	LOAD_STATS stats;
+	GetLoadStats(stats);
+
+	DebugPrintf("%ld bytes free in the heap\n", MemoryFreeSpace());
+	DebugPrintf("%u loads stalled LockMem() for %u ms\n", stats.stalls, stats.stallTime);
+	DebugPrintf("%u handles preloaded in %u ms, %u still queued\n", stats.preloads, stats.preloadTime, stats.queued);
+
+	return true;
+}
+
 } // End of namespace Tinsel
@@ -23,7 +23,11 @@
 
 #define BODGE
 
+#include "common/algorithm.h"
+#include "common/array.h"
 #include "common/file.h"
+#include "common/hashmap.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 
 #include "tinsel/drives.h"
@@ -82,6 +86,20 @@ static Common::File *g_cdGraphStream = 0;
 
 static char g_szCdPlayFile[100];
 
+typedef Common::Array<uint32> HandleList;
+typedef Common::HashMap<uint32, HandleList> ScenePreloadMap;
+
+// handles each scene had to load from disk, preloaded when it is entered again
+static ScenePreloadMap *g_scenePreloads = 0;
+
+// handles waiting to be preloaded, the next one last
+static HandleList *g_preloadQueue = 0;
+
+// handle of the current scene, whose loads are being recorded
+static uint32 g_preloadScene = 0;
+
+static LOAD_STATS g_loadStats;
+
 //----------------- FORWARD REFERENCES --------------------
 
 static void LoadFile(MEMHANDLE *pH);	// load a memory block as a file
@@ -146,6 +164,11 @@ void SetupHandleTable() {
 		error(CANNOT_FIND_FILE, indexFileName);
 	}
 
+	g_scenePreloads = new ScenePreloadMap();
+	g_preloadQueue = new HandleList();
+	g_preloadScene = 0;
+	memset(&g_loadStats, 0, sizeof(g_loadStats));
+
 	// allocate memory nodes and load all permanent graphics
 	for (i = 0, pH = g_handleTable; i < g_numHandles; i++, pH++) {
 		if (pH->filesize & fPreload) {
@@ -179,6 +202,11 @@ void FreeHandleTable() {
 
 	delete g_cdGraphStream;
 	g_cdGraphStream = NULL;
+
+	delete g_scenePreloads;
+	g_scenePreloads = NULL;
+	delete g_preloadQueue;
+	g_preloadQueue = NULL;
 }
 
 /**
@@ -316,6 +344,71 @@ void LoadFile(MEMHANDLE *pH) {
 	error(CANNOT_FIND_FILE, szFilename);
 }
 
+/**
+ * Reallocates and loads the data of a discarded handle.
+ * @param pH			Memory block pointer
+ */
+static void ReloadFile(MEMHANDLE *pH) {
+	MemoryReAlloc(pH->_node, pH->filesize & FSIZE_MASK);
+
+	if (TinselV2) {
+		SetCD(pH->flags2 & fAllCds);
+		CdCD(Common::nullContext);
+	}
+	LoadFile(pH);
+}
+
+/**
+ * Remembers that the current scene had to load the given handle from disk,
+ * so that it can be preloaded next time the scene is entered.
+ * @param handle		Memory handle
+ */
+static void RecordSceneLoad(uint32 handle) {
+	if (!g_preloadScene || handle == g_preloadScene)
+		return;
+
+	HandleList &handles = (*g_scenePreloads)[g_preloadScene];
+	if (Common::find(handles.begin(), handles.end(), handle) == handles.end())
+		handles.push_back(handle);
+}
+
+/**
+ * Loads the handles the current scene is expected to need, for as long as
+ * there is time left before the next game cycle.
+ * Handles are only preloaded if they fit in the heap without discarding
+ * anything, so preloading never causes other data to be reloaded.
+ * @param endTime		Time by which to stop preloading
+ */
+void PreloadHandles(uint32 endTime) {
+	while (g_preloadQueue && !g_preloadQueue->empty() && g_system->getMillis() < endTime) {
+		uint32 startTime = g_system->getMillis();
+		MEMHANDLE *pH = g_handleTable + g_preloadQueue->back();
+		g_preloadQueue->pop_back();
+
+		// already loaded, or it would mean swapping CDs
+		if (!pH->_node || MemoryDeref(pH->_node))
+			continue;
+		if (TinselV2 && !(pH->flags2 & (1 << (GetCurrentCD() - 1))))
+			continue;
+
+		if (MemoryFreeSpace() < (long)(pH->filesize & FSIZE_MASK) + (long)sizeof(void *))
+			continue;
+
+		ReloadFile(pH);
+
+		g_loadStats.preloads++;
+		g_loadStats.preloadTime += g_system->getMillis() - startTime;
+	}
+}
+
+/**
+ * Returns the counters of data loaded by LockMem() and by preloading.
+ */
+void GetLoadStats(LOAD_STATS &stats) {
+	stats = g_loadStats;
+	stats.queued = g_preloadQueue ? g_preloadQueue->size() : 0;
+}
+
 /**
  * Compute and return the address specified by a SCNHANDLE.
  * @param offset			Handle and offset to data
@@ -344,6 +437,8 @@ byte *LockMem(SCNHANDLE offset) {
 
 		// May have been discarded, if so, we have to reload
 		if (!MemoryDeref(pH->_node)) {
+			uint32 startTime = g_system->getMillis();
+
 			// Data was discarded, we have to reload
 			MemoryReAlloc(pH->_node, g_cdTopHandle - g_cdBaseHandle);
 
@@ -351,6 +446,9 @@ byte *LockMem(SCNHANDLE offset) {
 
 			// update the LRU time (new in this file)
 			MemoryTouch(pH->_node);
+
+			g_loadStats.stalls++;
+			g_loadStats.stallTime += g_system->getMillis() - startTime;
 		}
 
 		// make sure address is valid
@@ -359,14 +457,14 @@ byte *LockMem(SCNHANDLE offset) {
 		offset -= g_cdBaseHandle;
 	} else {
 		if (!MemoryDeref(pH->_node)) {
+			uint32 startTime = g_system->getMillis();
+
 			// Data was discarded, we have to reload
-			MemoryReAlloc(pH->_node, pH->filesize & FSIZE_MASK);
+			ReloadFile(pH);
+			RecordSceneLoad(handle);
 
-			if (TinselV2) {
-				SetCD(pH->flags2 & fAllCds);
-				CdCD(Common::nullContext);
-			}
-			LoadFile(pH);
+			g_loadStats.stalls++;
+			g_loadStats.stallTime += g_system->getMillis() - startTime;
 		}
 
 		// make sure address is valid
@@ -404,6 +502,15 @@ void LockScene(SCNHANDLE offset) {
 #ifdef DEBUG
 		s_lockedScene = handle;
 #endif
+
+		// Queue whatever the scene had to load last time it was entered
+		g_preloadScene = handle;
+		g_preloadQueue->clear();
+		if (g_scenePreloads->contains(handle)) {
+			const HandleList &handles = (*g_scenePreloads)[handle];
+			for (uint i = handles.size(); i > 0; --i)
+				g_preloadQueue->push_back(handles[i - 1]);
+		}
 	}
 }
 
@@ -428,6 +535,10 @@ void UnlockScene(SCNHANDLE offset) {
 #ifdef DEBUG
 		s_lockedScene = 0;
 #endif
+
+		// Nothing left to preload for the scene
+		g_preloadScene = 0;
+		g_preloadQueue->clear();
 	}
 }
 
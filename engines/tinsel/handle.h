@@ -28,6 +28,15 @@
 
 namespace Tinsel {
 
+/** Counters of the data loaded from disk by the memory manager */
+struct LOAD_STATS {
+	uint32 stalls;		///< number of times LockMem() had to wait for a load
+	uint32 stallTime;	///< milliseconds spent in those loads
+	uint32 preloads;	///< number of handles preloaded while idle
+	uint32 preloadTime;	///< milliseconds spent preloading
+	uint32 queued;		///< number of handles still waiting to be preloaded
+};
+
 /*----------------------------------------------------------------------*\
 |*                              Function Prototypes                     *|
 \*----------------------------------------------------------------------*/
@@ -59,6 +68,11 @@ void LoadExtraGraphData(
 
 int CdNumber(SCNHANDLE offset);
 
+// Called while waiting for the next game cycle
+void PreloadHandles(uint32 endTime);
+
+void GetLoadStats(LOAD_STATS &stats);
+
 } // End of namespace Tinsel
 
 #endif	// TINSEL_HANDLE_H
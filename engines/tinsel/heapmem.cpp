@@ -45,6 +45,8 @@ struct MEM_NODE {
 	long size;		// size of the memory object
 	uint32 lruTime;		// time when memory object was last accessed
 	int flags;		// allocation attributes
+	MEM_NODE *pLruNext;	// link to the next more recently used discardable node
+	MEM_NODE *pLruPrev;	// link to the previous less recently used discardable node
 };
 
 
@@ -69,9 +71,55 @@ MEM_NODE g_s_fixedMnodesList[5];
 // the mnode heap sentinel
 static MEM_NODE g_heapSentinel;
 
+// sentinel of the discardable mnodes, ordered from least to most recently used
+static MEM_NODE g_lruSentinel;
+
 //
 static MEM_NODE *AllocMemNode();
 
+/**
+ * Returns true if the memory object may be discarded to make room in the heap,
+ * i.e. it is a heap node which is in use, not discarded and not locked.
+ */
+static bool IsDiscardable(const MEM_NODE *pMemNode) {
+	return pMemNode->flags == DWM_USED
+		&& pMemNode >= g_mnodeList && pMemNode <= g_mnodeList + NUM_MNODES - 1;
+}
+
+/**
+ * Removes a mnode from the discardable list, if it is on it.
+ * @param pMemNode			Node of the memory object
+ */
+static void LruUnlink(MEM_NODE *pMemNode) {
+	if (pMemNode->pLruNext) {
+		pMemNode->pLruNext->pLruPrev = pMemNode->pLruPrev;
+		pMemNode->pLruPrev->pLruNext = pMemNode->pLruNext;
+		pMemNode->pLruNext = pMemNode->pLruPrev = NULL;
+	}
+}
+
+/**
+ * Puts a mnode back on the discardable list at the position for its LRU time,
+ * or takes it off the list if it can no longer be discarded.
+ * @param pMemNode			Node of the memory object
+ */
+static void LruUpdate(MEM_NODE *pMemNode) {
+	LruUnlink(pMemNode);
+
+	if (!IsDiscardable(pMemNode))
+		return;
+
+	// LRU times hardly ever go backwards, so search from the most recent end
+	MEM_NODE *pPrev = g_lruSentinel.pLruPrev;
+	while (pPrev != &g_lruSentinel && pPrev->lruTime > pMemNode->lruTime)
+		pPrev = pPrev->pLruPrev;
+
+	pMemNode->pLruPrev = pPrev;
+	pMemNode->pLruNext = pPrev->pLruNext;
+	pPrev->pLruNext->pLruPrev = pMemNode;
+	pPrev->pLruNext = pMemNode;
+}
+
 #ifdef DEBUG
 static void MemoryStats() {
 	int usedNodes = 0;
@@ -79,6 +127,7 @@ static void MemoryStats() {
 	int lockedNodes = 0;
 	int lockedSize = 0;
 	int totalSize = 0;
+	int discardableNodes = 0;
 
 	const MEM_NODE *pHeap = &g_heapSentinel;
 	MEM_NODE *pCur;
@@ -94,8 +143,11 @@ static void MemoryStats() {
 		}
 	}
 
-	debug("%d nodes used, %d alloced, %d locked; %d bytes locked, %d used",
-			usedNodes, allocedNodes, lockedNodes, lockedSize, totalSize);
+	for (pCur = g_lruSentinel.pLruNext; pCur != &g_lruSentinel; pCur = pCur->pLruNext)
+		discardableNodes++;
+
+	debug("%d nodes used, %d alloced, %d locked, %d discardable; %d bytes locked, %d used",
+			usedNodes, allocedNodes, lockedNodes, discardableNodes, lockedSize, totalSize);
 }
 #endif
 
@@ -125,6 +177,11 @@ void MemoryInit() {
 	// flag sentinel as locked
 	g_heapSentinel.flags = DWM_LOCKED | DWM_SENTINEL;
 
+	// no discardable mnodes yet
+	g_lruSentinel.pLruPrev = &g_lruSentinel;
+	g_lruSentinel.pLruNext = &g_lruSentinel;
+	g_lruSentinel.flags = DWM_LOCKED | DWM_SENTINEL;
+
 	// store the current heap size in the sentinel
 	uint32 size = MemoryPoolSize[0];
 	if (TinselVersion == TINSEL_V1) size = MemoryPoolSize[1];
@@ -194,31 +251,17 @@ void FreeMemNode(MEM_NODE *pMemNode) {
  * @return true if any blocks were discarded, false otherwise
  */
 static bool HeapCompact(long size) {
-	const MEM_NODE *pHeap = &g_heapSentinel;
-	MEM_NODE *pCur, *pOldest;
-	uint32 oldest;		// time of the oldest discardable block
-
 	while (g_heapSentinel.size < size) {
+		// the oldest discardable block is at the head of the LRU list
+		MEM_NODE *pOldest = g_lruSentinel.pLruNext;
 
-		// find the oldest discardable block
-		oldest = DwGetCurrentTime();
-		pOldest = NULL;
-		for (pCur = pHeap->pNext; pCur != pHeap; pCur = pCur->pNext) {
-			if (pCur->flags == DWM_USED) {
-				// found a non-discarded discardable block
-				if (pCur->lruTime < oldest) {
-					oldest = pCur->lruTime;
-					pOldest = pCur;
-				}
-			}
-		}
-
-		if (pOldest)
-			// discard the oldest block
-			MemoryDiscard(pOldest);
-		else
+		// blocks used during the current tick are never discarded
+		if (pOldest == &g_lruSentinel || pOldest->lruTime >= DwGetCurrentTime())
 			// cannot discard any blocks
 			return false;
+
+		// discard the oldest block
+		MemoryDiscard(pOldest);
 	}
 
 	// we have freed enough memory
@@ -361,6 +404,8 @@ void MemoryDiscard(MEM_NODE *pMemNode) {
 		pMemNode->flags |= DWM_DISCARDED;
 		pMemNode->pBaseAddr = NULL;
 		pMemNode->size = 0;
+
+		LruUnlink(pMemNode);
 	}
 }
 
@@ -379,6 +424,7 @@ void *MemoryLock(MEM_NODE *pMemNode) {
 
 	// set the lock flag
 	pMemNode->flags |= DWM_LOCKED;
+	LruUnlink(pMemNode);
 
 #ifdef DEBUG
 	MemoryStats();
@@ -405,6 +451,7 @@ void MemoryUnlock(MEM_NODE *pMemNode) {
 
 	// update the LRU time
 	pMemNode->lruTime = DwGetCurrentTime();
+	LruUpdate(pMemNode);
 }
 
 /**
@@ -446,6 +493,9 @@ void MemoryReAlloc(MEM_NODE *pMemNode, long size) {
 		pMemNode->pPrev->pNext = pMemNode;
 		pMemNode->pNext->pPrev = pMemNode;
 
+		// the block can now be discarded again
+		LruUpdate(pMemNode);
+
 		// free the new node
 		FreeMemNode(pNew);
 	}
@@ -460,11 +510,19 @@ void MemoryReAlloc(MEM_NODE *pMemNode, long size) {
 void MemoryTouch(MEM_NODE *pMemNode) {
 	// update the LRU time
 	pMemNode->lruTime = DwGetCurrentTime();
+	LruUpdate(pMemNode);
 }
 
 uint8 *MemoryDeref(MEM_NODE *pMemNode) {
 	return pMemNode->pBaseAddr;
 }
 
+/**
+ * Returns the number of bytes which can be allocated without discarding anything.
+ */
+long MemoryFreeSpace() {
+	return g_heapSentinel.size;
+}
+
 
 } // End of namespace Tinsel
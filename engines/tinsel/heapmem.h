@@ -63,6 +63,9 @@ void MemoryTouch(MEM_NODE *pMemNode);
 // Dereference a given memory node
 uint8 *MemoryDeref(MEM_NODE *pMemNode);
 
+// Returns the number of bytes which can be allocated without discarding anything
+long MemoryFreeSpace();
+
 } // End of namespace Tinsel
 
 #endif
@@ -1001,6 +1001,9 @@ Common::Error TinselEngine::run() {
 
 		DoCdChange();
 
+		// Use the time left until the next game cycle to load ahead
+		PreloadHandles(timerVal + GAME_FRAME_DELAY);
+
 		if (_bmv->MoviePlaying() && _bmv->NextMovieTime())
 			g_system->delayMillis(MAX<int>(_bmv->NextMovieTime() - g_system->getMillis() + _bmv->MovieAudioLag(), 0));
 		else
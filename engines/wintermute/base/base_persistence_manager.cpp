@@ -413,7 +413,12 @@ bool BasePersistenceManager::saveFile(const Common::String &filename) {
 	uint32 bufferSize = ((Common::MemoryWriteStreamDynamic *)_saveStream)->size();
 
 	Common::SaveFileManager *saveMan = ((WintermuteEngine *)g_engine)->getSaveFileMan();
-	Common::OutSaveFile *file = saveMan->openForSaving(filename);
+	// The whole save is already serialized, so let the savefile manager
+	// compress and write it without holding up the game.
+	Common::OutSaveFile *file = saveMan->openForSavingInBackground(filename);
+	if (!file) {
+		return false;
+	}
 	file->write(prefixBuffer, prefixSize);
 	file->write(buffer, bufferSize);
 	bool retVal = !file->err();
@@ -266,6 +266,13 @@ public:
 		_activeSurface = surface;
 	}
 
+	/**
+	 * Returns the active drawing surface.
+	 */
+	Surface *getSurface() const {
+		return _activeSurface;
+	}
+
 	/**
 	 * Fills the active surface with the specified fg/bg color or the active gradient.
 	 * Defaults to using the active Foreground color for filling.
@@ -418,6 +425,26 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Sets the colors specified by a draw step, exactly like drawStep()
+	 * does before drawing. Colors which the step does not specify are
+	 * kept, so they carry over from the previously drawn steps.
+	 *
+	 * @param step Pointer to a DrawStep struct.
+	 */
+	void setStepColors(const DrawStep &step);
+
+	/** Number of colors returned by getColors(). */
+	static const int kColorCount = 5;
+
+	/**
+	 * Returns the active colors of the renderer in the surface's pixel
+	 * format: foreground, background, bevel, gradient start and gradient
+	 * end. Used to tell apart renderings which depend on colors carried
+	 * over from previous draw steps.
+	 */
+	virtual void getColors(uint32 colors[kColorCount]) const = 0;
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -474,6 +501,7 @@ public:
 	 */
 	virtual void disableShadows() { _disableShadows = true; }
 	virtual void enableShadows() { _disableShadows = false; }
+	bool shadowsEnabled() const { return !_disableShadows; }
 
 	/**
 	 * Applies a whole-screen shading effect, used before opening a new dialog.
@@ -33,6 +33,16 @@
 
 #define VECTOR_RENDERER_FAST_TRIANGLES
 
+// SSE2 is always available on x86-64 and NEON on ARM64, so the span fills
+// below use them whenever the compiler targets them.
+#if defined(__SSE2__)
+#define USE_SSE2_SPANS
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define USE_NEON_SPANS
+#include <arm_neon.h>
+#endif
+
 /** Fixed point SQUARE ROOT **/
 inline frac_t fp_sqroot(uint32 x) {
 #if 0
@@ -238,17 +248,71 @@ inline frac_t fp_sqroot(uint32 x) {
 
 namespace Graphics {
 
+/**
+ * Fills several pixels in a row with two alternating colors, starting with
+ * the even one. The plain color fill and the dithered gradient rows both
+ * end up here.
+ *
+ * @param first Pointer to the first pixel to fill.
+ * @param count Number of pixels to fill.
+ * @param even Color of the pixels at even offsets from first.
+ * @param odd Color of the pixels at odd offsets from first.
+ */
+template<typename PixelType>
+static inline void patternFill(PixelType *first, int count, PixelType even, PixelType odd) {
+#if defined(USE_SSE2_SPANS) || defined(USE_NEON_SPANS)
+	// A vector always holds an even number of pixels, so the pattern stays
+	// in phase from one vector to the next and for the scalar tail.
+	const int perVector = 16 / sizeof(PixelType);
+	if (count >= perVector) {
+		PixelType pattern[16 / sizeof(PixelType)];
+		for (int i = 0; i < perVector; i += 2) {
+			pattern[i] = even;
+			pattern[i + 1] = odd;
+		}
+
+#ifdef USE_SSE2_SPANS
+		const __m128i v = _mm_loadu_si128((const __m128i *)pattern);
+		for (; count >= 2 * perVector; count -= 2 * perVector, first += 2 * perVector) {
+			_mm_storeu_si128((__m128i *)first, v);
+			_mm_storeu_si128((__m128i *)(first + perVector), v);
+		}
+		if (count >= perVector) {
+			_mm_storeu_si128((__m128i *)first, v);
+			count -= perVector;
+			first += perVector;
+		}
+#else
+		const uint8x16_t v = vld1q_u8((const uint8 *)pattern);
+		for (; count >= 2 * perVector; count -= 2 * perVector, first += 2 * perVector) {
+			vst1q_u8((uint8 *)first, v);
+			vst1q_u8((uint8 *)(first + perVector), v);
+		}
+		if (count >= perVector) {
+			vst1q_u8((uint8 *)first, v);
+			count -= perVector;
+			first += perVector;
+		}
+#endif
+	}
+#endif
+
+	for (int i = 0; i < count; i += 2) {
+		first[i] = even;
+		if (i + 1 < count)
+			first[i + 1] = odd;
+	}
+}
+
 /**
  * Fills several pixels in a row with a given color.
  *
- * This is a replacement function for Common::fill, using an unrolled
- * loop to maximize performance on most architectures.
- * This function may (and should) be overloaded in any child renderers
- * for portable platforms with platform-specific assembly code.
+ * This is a replacement function for Common::fill. Long runs are written a
+ * whole vector at a time when SSE2 or NEON is available; short ones use an
+ * unrolled loop.
  *
  * This fill operation is extensively used throughout the renderer, so this
- * counts as one of the main bottlenecks. Please replace it with assembly
- * when possible!
+ * counts as one of the main bottlenecks.
  *
  * @param first Pointer to the first pixel to fill.
  * @param last Pointer to the last pixel to fill.
@@ -259,6 +323,12 @@ void colorFill(PixelType *first, PixelType *last, PixelType color) {
 	register int count = (last - first);
 	if (!count)
 		return;
+#if defined(USE_SSE2_SPANS) || defined(USE_NEON_SPANS)
+	if (count >= 16) {
+		patternFill<PixelType>(first, count, color, color);
+		return;
+	}
+#endif
 	register int n = (count + 7) >> 3;
 	switch (count % 8) {
 	case 0: do {
@@ -274,6 +344,126 @@ void colorFill(PixelType *first, PixelType *last, PixelType color) {
 	}
 }
 
+/**
+ * Applies ((pixel & andMask) >> shift) + addMask) | orMask to as many whole
+ * vectors of pixels as fit in the row, which covers both the shadow
+ * darkening and the dimmed screen shading.
+ *
+ * @return Pointer to the first pixel which still has to be handled by the
+ *         caller.
+ */
+template<typename PixelType>
+static inline PixelType *shadeSpan(PixelType *first, int count, PixelType andMask, int shift, PixelType addMask, PixelType orMask) {
+#if defined(USE_SSE2_SPANS)
+	if (sizeof(PixelType) == 2) {
+		const __m128i vAnd = _mm_set1_epi16((int16)andMask);
+		const __m128i vAdd = _mm_set1_epi16((int16)addMask);
+		const __m128i vOr = _mm_set1_epi16((int16)orMask);
+		const __m128i vShift = _mm_cvtsi32_si128(shift);
+		for (; count >= 8; count -= 8, first += 8) {
+			__m128i p = _mm_loadu_si128((const __m128i *)first);
+			p = _mm_srl_epi16(_mm_and_si128(p, vAnd), vShift);
+			_mm_storeu_si128((__m128i *)first, _mm_or_si128(_mm_add_epi16(p, vAdd), vOr));
+		}
+	} else {
+		const __m128i vAnd = _mm_set1_epi32((int32)andMask);
+		const __m128i vAdd = _mm_set1_epi32((int32)addMask);
+		const __m128i vOr = _mm_set1_epi32((int32)orMask);
+		const __m128i vShift = _mm_cvtsi32_si128(shift);
+		for (; count >= 4; count -= 4, first += 4) {
+			__m128i p = _mm_loadu_si128((const __m128i *)first);
+			p = _mm_srl_epi32(_mm_and_si128(p, vAnd), vShift);
+			_mm_storeu_si128((__m128i *)first, _mm_or_si128(_mm_add_epi32(p, vAdd), vOr));
+		}
+	}
+#elif defined(USE_NEON_SPANS)
+	if (sizeof(PixelType) == 2) {
+		const uint16x8_t vAnd = vdupq_n_u16((uint16)andMask);
+		const uint16x8_t vAdd = vdupq_n_u16((uint16)addMask);
+		const uint16x8_t vOr = vdupq_n_u16((uint16)orMask);
+		const int16x8_t vShift = vdupq_n_s16(-shift);
+		for (; count >= 8; count -= 8, first += 8) {
+			uint16x8_t p = vld1q_u16((const uint16 *)first);
+			p = vshlq_u16(vandq_u16(p, vAnd), vShift);
+			vst1q_u16((uint16 *)first, vorrq_u16(vaddq_u16(p, vAdd), vOr));
+		}
+	} else {
+		const uint32x4_t vAnd = vdupq_n_u32((uint32)andMask);
+		const uint32x4_t vAdd = vdupq_n_u32((uint32)addMask);
+		const uint32x4_t vOr = vdupq_n_u32((uint32)orMask);
+		const int32x4_t vShift = vdupq_n_s32(-shift);
+		for (; count >= 4; count -= 4, first += 4) {
+			uint32x4_t p = vld1q_u32((const uint32 *)first);
+			p = vshlq_u32(vandq_u32(p, vAnd), vShift);
+			vst1q_u32((uint32 *)first, vorrq_u32(vaddq_u32(p, vAdd), vOr));
+		}
+	}
+#endif
+	return first;
+}
+
+/**
+ * Blends as many whole vectors of 16 bit pixels as fit in the row with the
+ * given color, producing exactly what blendPixelPtr() does per pixel.
+ *
+ * Each color component is handled in its own 16 bit lane, so this is only
+ * possible when no component is wider than 7 bits; the caller checks that.
+ *
+ * @return Pointer to the first pixel which still has to be handled by the
+ *         caller.
+ */
+static inline uint16 *blendSpan16(uint16 *first, int count, uint16 color, uint8 alpha, const PixelFormat &format) {
+#if defined(USE_SSE2_SPANS) || defined(USE_NEON_SPANS)
+	const int shifts[3] = { format.rShift, format.gShift, format.bShift };
+	const int masks[3] = { 0xFF >> format.rLoss, 0xFF >> format.gLoss, 0xFF >> format.bLoss };
+	const uint16 alphaMask = (uint16)((0xFF >> format.aLoss) << format.aShift);
+#endif
+
+#if defined(USE_SSE2_SPANS)
+	const __m128i vAlpha = _mm_set1_epi16(alpha);
+	const __m128i vKeep = _mm_set1_epi16((int16)alphaMask);
+	__m128i vShift[3], vMask[3], vSrc[3];
+	for (int c = 0; c < 3; ++c) {
+		vShift[c] = _mm_cvtsi32_si128(shifts[c]);
+		vMask[c] = _mm_set1_epi16(masks[c]);
+		vSrc[c] = _mm_set1_epi16((color >> shifts[c]) & masks[c]);
+	}
+
+	for (; count >= 8; count -= 8, first += 8) {
+		const __m128i d = _mm_loadu_si128((const __m128i *)first);
+		__m128i out = _mm_and_si128(d, vKeep);
+		for (int c = 0; c < 3; ++c) {
+			const __m128i dc = _mm_and_si128(_mm_srl_epi16(d, vShift[c]), vMask[c]);
+			const __m128i delta = _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(vSrc[c], dc), vAlpha), 8);
+			out = _mm_or_si128(out, _mm_sll_epi16(_mm_add_epi16(dc, delta), vShift[c]));
+		}
+		_mm_storeu_si128((__m128i *)first, out);
+	}
+#elif defined(USE_NEON_SPANS)
+	const int16x8_t vAlpha = vdupq_n_s16(alpha);
+	const uint16x8_t vKeep = vdupq_n_u16(alphaMask);
+	int16x8_t vShiftLeft[3], vShiftRight[3], vMask[3], vSrc[3];
+	for (int c = 0; c < 3; ++c) {
+		vShiftLeft[c] = vdupq_n_s16(shifts[c]);
+		vShiftRight[c] = vdupq_n_s16(-shifts[c]);
+		vMask[c] = vdupq_n_s16(masks[c]);
+		vSrc[c] = vdupq_n_s16((color >> shifts[c]) & masks[c]);
+	}
+
+	for (; count >= 8; count -= 8, first += 8) {
+		const uint16x8_t d = vld1q_u16(first);
+		uint16x8_t out = vandq_u16(d, vKeep);
+		for (int c = 0; c < 3; ++c) {
+			const int16x8_t dc = vandq_s16(vreinterpretq_s16_u16(vshlq_u16(d, vShiftRight[c])), vMask[c]);
+			const int16x8_t delta = vshrq_n_s16(vmulq_s16(vsubq_s16(vSrc[c], dc), vAlpha), 8);
+			out = vorrq_u16(out, vshlq_u16(vreinterpretq_u16_s16(vaddq_s16(dc, delta)), vShiftLeft[c]));
+		}
+		vst1q_u16(first, out);
+	}
+#endif
+	return first;
+}
+
 
 VectorRenderer *createRenderer(int mode) {
 #ifdef DISABLE_FANCY_THEMES
@@ -302,7 +492,8 @@ VectorRendererSpec(PixelFormat format) :
 	_redMask((0xFF >> format.rLoss) << format.rShift),
 	_greenMask((0xFF >> format.gLoss) << format.gShift),
 	_blueMask((0xFF >> format.bLoss) << format.bShift),
-	_alphaMask((0xFF >> format.aLoss) << format.aShift) {
+	_alphaMask((0xFF >> format.aLoss) << format.aShift),
+	_fgColor(0), _bgColor(0), _gradientStart(0), _gradientEnd(0), _bevelColor(0) {
 
 	_bitmapAlphaColor = _format.RGBToColor(255, 0, 255);
 }
@@ -381,16 +572,20 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		// The pattern only depends on the parity of the column, so the row
+		// alternates between two colors.
+		PixelType evenColor = _gradCache[curGrad];
+		PixelType oddColor = _gradCache[curGrad];
+
+		if ((grad == 2 || grad == 3) && ox)
+			evenColor = _gradCache[curGrad + 1];
+		if (ox || grad == 3)
+			oddColor = _gradCache[curGrad + 1];
+
+		if (x & 1)
+			patternFill<PixelType>(ptr, width, oddColor, evenColor);
+		else
+			patternFill<PixelType>(ptr, width, evenColor, oddColor);
 	}
 }
 
@@ -520,7 +715,9 @@ applyScreenShading(GUI::ThemeEngine::ShadingStyle shadingStyle) {
 	if (shadingStyle == GUI::ThemeEngine::kShadingDim) {
 
 		// TODO: Check how this interacts with kFeatureOverlaySupportsAlpha
-		for (int i = 0; i < pixels; ++i) {
+		PixelType *end = ptr + pixels;
+		ptr = shadeSpan<PixelType>(ptr, pixels, (PixelType)colorMask, 1, 0, _alphaMask);
+		while (ptr != end) {
 			*ptr = ((*ptr & colorMask) >> 1) | _alphaMask;
 			++ptr;
 		}
@@ -570,6 +767,16 @@ blendPixelDestAlphaPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+	if (sizeof(PixelType) == 2 && _format.rLoss && _format.gLoss && _format.bLoss)
+		first = (PixelType *)blendSpan16((uint16 *)first, last - first, (uint16)color, alpha, _format);
+
+	while (first != last)
+		blendPixelPtr(first++, color, alpha);
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 darkenFill(PixelType *ptr, PixelType *end) {
@@ -578,6 +785,7 @@ darkenFill(PixelType *ptr, PixelType *end) {
 	if (!g_system->hasFeature(OSystem::kFeatureOverlaySupportsAlpha)) {
 		// !kFeatureOverlaySupportsAlpha (but might have alpha bits)
 
+		ptr = shadeSpan<PixelType>(ptr, end - ptr, (PixelType)~mask, 2, 0, _alphaMask);
 		while (ptr != end) {
 			*ptr = ((*ptr & ~mask) >> 2) | _alphaMask;
 			++ptr;
@@ -590,6 +798,7 @@ darkenFill(PixelType *ptr, PixelType *end) {
 		PixelType addA = (PixelType)(255 >> _format.aLoss) << _format.aShift;
 		addA -= (addA >> 2);
 
+		ptr = shadeSpan<PixelType>(ptr, end - ptr, (PixelType)~mask, 2, addA, 0);
 		while (ptr != end) {
 			// Darken the colour, and increase the alpha
 			// (0% -> 75%, 100% -> 100%)
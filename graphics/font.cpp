@@ -22,10 +22,60 @@
 #include "graphics/font.h"
 
 #include "common/array.h"
+#include "common/hash-str.h"
 #include "common/util.h"
 
 namespace Graphics {
 
+namespace {
+
+/** Number of laid out strings kept per font */
+const int kTextRunCacheSize = 64;
+
+/** Longer strings are laid out on every call instead of being cached */
+const uint kMaxTextRunLength = 256;
+
+} // End of anonymous namespace
+
+/**
+ * A string as drawString() draws it: the text which is left after
+ * shortening it to the available width, and where every character of it
+ * goes relative to the start of the string.
+ */
+struct Font::TextRun {
+	// Key
+	Common::String text;
+	uint hash;
+	int w;
+	bool useEllipsis;
+
+	Common::String str;
+	int width;
+	Common::Array<int> offsets;
+	Common::Array<int> widths;
+
+	uint32 lastUse;
+
+	TextRun() : hash(0), w(0), useEllipsis(false), width(0), lastUse(0) {}
+};
+
+class Font::TextRunCache {
+public:
+	TextRunCache() : counter(0) {}
+
+	TextRun runs[kTextRunCacheSize];
+	uint32 counter;
+};
+
+Font::~Font() {
+	delete _runCache;
+}
+
+void Font::invalidateLayoutCache() {
+	delete _runCache;
+	_runCache = 0;
+}
+
 int Font::getKerningOffset(byte left, byte right) const {
 	return 0;
 }
@@ -43,13 +93,12 @@ int Font::getStringWidth(const Common::String &str) const {
 	return space;
 }
 
-void Font::drawString(Surface *dst, const Common::String &sOld, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) const {
-	assert(dst != 0);
-	const int leftX = x, rightX = x + w;
+void Font::layoutString(const Common::String &sOld, int w, bool useEllipsis, TextRun &run) const {
 	uint i;
 	Common::String s = sOld;
 	int width = getStringWidth(s);
-	Common::String str;
+	Common::String &str = run.str;
+	str.clear();
 
 	if (useEllipsis && width > w && s.hasSuffix("...")) {
 		// String is too wide. Check whether it ends in an ellipsis
@@ -114,23 +163,73 @@ void Font::drawString(Surface *dst, const Common::String &sOld, int x, int y, in
 		str = s;
 	}
 
-	if (align == kTextAlignCenter)
-		x = x + (w - width)/2;
-	else if (align == kTextAlignRight)
-		x = x + w - width;
-	x += deltax;
+	run.width = width;
+	run.offsets.resize(str.size());
+	run.widths.resize(str.size());
 
+	int x = 0;
 	uint last = 0;
 	for (i = 0; i < str.size(); ++i) {
 		const uint cur = str[i];
 		x += getKerningOffset(last, cur);
 		last = cur;
-		w = getCharWidth(cur);
-		if (x+w > rightX)
+		run.offsets[i] = x;
+		run.widths[i] = getCharWidth(cur);
+		x += run.widths[i];
+	}
+}
+
+const Font::TextRun &Font::getTextRun(const Common::String &str, int w, bool useEllipsis) const {
+	if (!_runCache)
+		_runCache = new TextRunCache();
+
+	const uint hash = Common::hashit(str.c_str());
+	TextRun *oldest = &_runCache->runs[0];
+
+	for (int i = 0; i < kTextRunCacheSize; ++i) {
+		TextRun &run = _runCache->runs[i];
+
+		if (run.lastUse && run.hash == hash && run.w == w && run.useEllipsis == useEllipsis && run.text == str) {
+			run.lastUse = ++_runCache->counter;
+			return run;
+		}
+
+		if (run.lastUse < oldest->lastUse)
+			oldest = &run;
+	}
+
+	oldest->text = str;
+	oldest->hash = hash;
+	oldest->w = w;
+	oldest->useEllipsis = useEllipsis;
+	oldest->lastUse = ++_runCache->counter;
+	layoutString(str, w, useEllipsis, *oldest);
+	return *oldest;
+}
+
+void Font::drawString(Surface *dst, const Common::String &s, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) const {
+	assert(dst != 0);
+	const int leftX = x, rightX = x + w;
+
+	TextRun uncached;
+	const TextRun *run = &uncached;
+	if (s.size() <= kMaxTextRunLength)
+		run = &getTextRun(s, w, useEllipsis);
+	else
+		layoutString(s, w, useEllipsis, uncached);
+
+	if (align == kTextAlignCenter)
+		x = x + (w - run->width)/2;
+	else if (align == kTextAlignRight)
+		x = x + w - run->width;
+	x += deltax;
+
+	for (uint i = 0; i < run->str.size(); ++i) {
+		const int charX = x + run->offsets[i];
+		if (charX + run->widths[i] > rightX)
 			break;
-		if (x >= leftX)
-			drawChar(dst, str[i], x, y, color);
-		x += w;
+		if (charX >= leftX)
+			drawChar(dst, run->str[i], charX, y, color);
 	}
 }
 
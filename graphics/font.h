@@ -47,8 +47,8 @@ enum TextAlign {
  */
 class Font {
 public:
-	Font() {}
-	virtual ~Font() {}
+	Font() : _runCache(0) {}
+	virtual ~Font();
 
 	/**
 	 * Query the height of the font.
@@ -120,6 +120,32 @@ public:
 	 * @return the maximal width of any of the lines added to lines
 	 */
 	int wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines) const;
+
+protected:
+	/**
+	 * Drop all cached string layouts. Fonts whose metrics change after
+	 * they were created, e.g. by loading another font into the same
+	 * object, have to call this.
+	 */
+	void invalidateLayoutCache();
+
+private:
+	struct TextRun;
+	class TextRunCache;
+
+	void layoutString(const Common::String &str, int w, bool useEllipsis, TextRun &run) const;
+	const TextRun &getTextRun(const Common::String &str, int w, bool useEllipsis) const;
+
+	/**
+	 * Recently drawn strings, already shortened and measured. This relies
+	 * on the metrics of a font only changing together with a call to
+	 * invalidateLayoutCache().
+	 */
+	mutable TextRunCache *_runCache;
+
+	// Copying a font would share its run cache
+	Font(const Font &);
+	Font &operator=(const Font &);
 };
 
 } // End of namespace Graphics
@@ -30,10 +30,14 @@
 namespace Graphics {
 
 BdfFont::BdfFont(const BdfFontData &data, DisposeAfterUse::Flag dispose)
-	: _data(data), _dispose(dispose) {
+	: _data(data), _dispose(dispose), _runs(0), _runOffsets(0) {
+	buildRuns();
 }
 
 BdfFont::~BdfFont() {
+	delete[] _runs;
+	delete[] _runOffsets;
+
 	if (_dispose == DisposeAfterUse::YES) {
 		for (int i = 0; i < _data.numCharacters; ++i)
 			delete[] _data.bitmaps[i];
@@ -66,28 +70,103 @@ int BdfFont::getCharWidth(byte chr) const {
 
 
 template<typename PixelType>
-void drawCharIntern(byte *ptr, uint pitch, const byte *src, int h, int width, int minX, int maxX, const PixelType color) {
-	byte data = 0;
+void drawCharIntern(byte *ptr, uint pitch, const uint16 *runs, int h, int minX, int maxX, const PixelType color) {
 	while (h--) {
 		PixelType *dst = (PixelType *)ptr;
 
-		for (int x = 0; x < width; ++x) {
-			if (!(x % 8))
-				data = *src++;
+		for (int count = *runs++; count > 0; --count, runs += 2) {
+			const int start = MAX<int>(runs[0], minX);
+			const int end = MIN<int>(runs[0] + runs[1] - 1, maxX);
 
-			if (x >= minX && x <= maxX && (data & 0x80))
+			for (int x = start; x <= end; ++x)
 				dst[x] = color;
-
-			data <<= 1;
 		}
 
 		ptr += pitch;
 	}
 }
 
+namespace {
+
+inline void getBoundingBox(const BdfFontData &data, int idx, int &width, int &height, int &xOffset, int &yOffset) {
+	if (!data.boxes) {
+		width = data.defaultBox.width;
+		height = data.defaultBox.height;
+		xOffset = data.defaultBox.xOffset;
+		yOffset = data.defaultBox.yOffset;
+	} else {
+		width = data.boxes[idx].width;
+		height = data.boxes[idx].height;
+		xOffset = data.boxes[idx].xOffset;
+		yOffset = data.boxes[idx].yOffset;
+	}
+}
+
+/**
+ * Converts one glyph row into runs of set pixels. When out is 0 only the
+ * size of the converted row is returned.
+ */
+uint convertRow(const byte *src, int width, uint16 *out) {
+	uint size = 1;
+	int count = 0;
+	int start = -1;
+
+	for (int x = 0; x <= width; ++x) {
+		const bool set = (x < width) && (src[x / 8] & (0x80 >> (x % 8)));
+
+		if (set && start < 0) {
+			start = x;
+		} else if (!set && start >= 0) {
+			if (out) {
+				out[size] = start;
+				out[size + 1] = x - start;
+			}
+			size += 2;
+			++count;
+			start = -1;
+		}
+	}
+
+	if (out)
+		out[0] = count;
+	return size;
+}
+
+} // End of anonymous namespace
+
+void BdfFont::buildRuns() {
+	if (_data.numCharacters <= 0)
+		return;
+
+	_runOffsets = new uint32[_data.numCharacters];
+
+	// Two passes: the first one sizes the run table, the second one fills it.
+	for (int pass = 0; pass < 2; ++pass) {
+		uint32 size = 0;
+
+		for (int i = 0; i < _data.numCharacters; ++i) {
+			_runOffsets[i] = size;
+
+			const byte *src = _data.bitmaps[i];
+			if (!src)
+				continue;
+
+			int width, height, xOffset, yOffset;
+			getBoundingBox(_data, i, width, height, xOffset, yOffset);
+
+			const int bytesPerRow = (width + 7) / 8;
+			for (int y = 0; y < height; ++y, src += bytesPerRow)
+				size += convertRow(src, width, _runs ? _runs + size : 0);
+		}
+
+		if (!pass)
+			_runs = new uint16[MAX<uint32>(size, 1)];
+	}
+}
+
 int BdfFont::mapToIndex(byte ch) const {
 	// Check whether the character is included
-	if (_data.firstCharacter <= ch && ch <= _data.firstCharacter + _data.numCharacters) {
+	if (_data.firstCharacter <= ch && ch < _data.firstCharacter + _data.numCharacters) {
 		if (_data.bitmaps[ch - _data.firstCharacter])
 			return ch - _data.firstCharacter;
 	}
@@ -105,37 +184,21 @@ void BdfFont::drawChar(Surface *dst, byte chr, const int tx, const int ty, const
 	assert(dst->format.bytesPerPixel == 1 || dst->format.bytesPerPixel == 2);
 
 	const int idx = mapToIndex(chr);
-	if (idx < 0)
+	if (idx < 0 || !_data.bitmaps[idx])
 		return;
 
 	int width, height, xOffset, yOffset;
-
-	// Get the bounding box of the character
-	if (!_data.boxes) {
-		width = _data.defaultBox.width;
-		height = _data.defaultBox.height;
-		xOffset = _data.defaultBox.xOffset;
-		yOffset = _data.defaultBox.yOffset;
-	} else {
-		width = _data.boxes[idx].width;
-		height = _data.boxes[idx].height;
-		xOffset = _data.boxes[idx].xOffset;
-		yOffset = _data.boxes[idx].yOffset;
-	}
+	getBoundingBox(_data, idx, width, height, xOffset, yOffset);
 
 	int y = ty + _data.ascent - yOffset - height;
 	int x = tx + xOffset;
 
-	const byte *src = _data.bitmaps[idx];
-
-	const int bytesPerRow = (width + 7) / 8;
-	const int originalWidth = width;
+	const uint16 *runs = _runs + _runOffsets[idx];
 
 	// Make sure we do not draw outside the surface
 	if (y < 0) {
-		src -= y * bytesPerRow;
-		height += y;
-		y = 0;
+		for (; y < 0 && height > 0; ++y, --height)
+			runs += 1 + 2 * runs[0];
 	}
 
 	if (y + height > dst->h)
@@ -162,9 +225,9 @@ void BdfFont::drawChar(Surface *dst, byte chr, const int tx, const int ty, const
 	byte *ptr = (byte *)dst->getBasePtr(x, y);
 
 	if (dst->format.bytesPerPixel == 1)
-		drawCharIntern<byte>(ptr, dst->pitch, src, height, originalWidth, xStart, xEnd, color);
+		drawCharIntern<byte>(ptr, dst->pitch, runs, height, xStart, xEnd, color);
 	else if (dst->format.bytesPerPixel == 2)
-		drawCharIntern<uint16>(ptr, dst->pitch, src, height, originalWidth, xStart, xEnd, color);
+		drawCharIntern<uint16>(ptr, dst->pitch, runs, height, xStart, xEnd, color);
 }
 
 namespace {
@@ -69,9 +69,19 @@ public:
 	static BdfFont *loadFromCache(Common::SeekableReadStream &stream);
 private:
 	int mapToIndex(byte ch) const;
+	void buildRuns();
 
 	const BdfFontData _data;
 	const DisposeAfterUse::Flag _dispose;
+
+	/**
+	 * The set pixels of every glyph as horizontal runs. Each row starts
+	 * with its number of runs followed by a (start, length) pair for
+	 * every run. These are 16 bit, so they do not depend on the glyph
+	 * width fitting into a byte.
+	 */
+	uint16 *_runs;
+	uint32 *_runOffsets; ///< Offset into _runs for every character
 };
 
 #define DEFINE_FONT(n) \
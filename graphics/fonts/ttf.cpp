@@ -33,7 +33,8 @@
 
 #include "common/singleton.h"
 #include "common/stream.h"
-#include "common/hashmap.h"
+#include "common/textconsole.h"
+#include "common/util.h"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -47,6 +48,31 @@ inline int ftCeil26_6(FT_Pos x) {
 	return (x + 63) / 64;
 }
 
+/** Range of a glyph row which has any coverage at all. */
+struct GlyphSpan {
+	uint16 first, last;
+};
+
+/**
+ * Recent results of blending the text color over a background pixel. Text
+ * is nearly always drawn over a flat background, so most of the partially
+ * covered pixels become a single lookup.
+ */
+struct BlendCache {
+	uint32 color;
+	PixelFormat format;
+
+	uint32 dst[256];
+	uint8 alpha[256]; ///< 0 marks an unused entry
+	uint32 result[256];
+
+	void reset(uint32 c, const PixelFormat &f) {
+		color = c;
+		format = f;
+		memset(alpha, 0, sizeof(alpha));
+	}
+};
+
 } // End of anonymous namespace
 
 class TTFLibrary : public Common::Singleton<TTFLibrary> {
@@ -123,14 +149,27 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
-		Surface image;
 		int xOffset, yOffset;
 		int advance;
+		int width, height;
+		uint32 atlasOffset; ///< Offset of the coverage data in _atlas
+		uint32 spanOffset;  ///< Offset of the row spans in _spans
 	};
 
-	bool cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr);
-	typedef Common::HashMap<byte, Glyph> GlyphCache;
-	GlyphCache _glyphs;
+	bool cacheGlyph(Glyph &glyph, Surface &image, FT_UInt &slot, uint chr);
+	void packGlyphs(Surface *images);
+
+	Glyph _glyphs[256];
+
+	/**
+	 * The coverage of all glyphs packed into one buffer, row after row
+	 * without any padding, so drawing a string stays within one block of
+	 * memory.
+	 */
+	uint8 *_atlas;
+	GlyphSpan *_spans;
+
+	mutable BlendCache _blendCache;
 
 	FT_UInt _glyphSlots[256];
 
@@ -140,7 +179,8 @@ private:
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _glyphSlots(), _monochrome(false), _hasKerning(false) {
+      _descent(0), _glyphs(), _atlas(0), _spans(0), _glyphSlots(), _monochrome(false), _hasKerning(false) {
+	_blendCache.reset(0, PixelFormat());
 }
 
 TTFFont::~TTFFont() {
@@ -150,11 +190,11 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	delete[] _atlas;
+	delete[] _spans;
 }
 
 bool TTFFont::load(Common::SeekableReadStream &stream, int size, uint dpi, bool monochrome, const uint32 *mapping) {
@@ -211,11 +251,16 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, uint dpi, bool
 	_width = ftCeil26_6(FT_MulFix(_face->max_advance_width, _face->size->metrics.x_scale));
 	_height = _ascent - _descent + 1;
 
+	Surface images[256];
+	bool loaded = false;
+
 	if (!mapping) {
 		// Load all ISO-8859-1 characters.
 		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], _glyphSlots[i], i))
+			if (!cacheGlyph(_glyphs[i], images[i], _glyphSlots[i], i))
 				_glyphSlots[i] = 0;
+			else
+				loaded = true;
 		}
 	} else {
 		for (uint i = 0; i < 256; ++i) {
@@ -223,18 +268,66 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, uint dpi, bool
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
 			// Check whether loading an important glyph fails and error out if
 			// that is the case.
-			if (!cacheGlyph(_glyphs[i], _glyphSlots[i], unicode)) {
+			if (!cacheGlyph(_glyphs[i], images[i], _glyphSlots[i], unicode)) {
 				_glyphSlots[i] = 0;
-				if (isRequired)
+				if (isRequired) {
+					for (uint j = 0; j <= i; ++j)
+						images[j].free();
 					return false;
+				}
+			} else {
+				loaded = true;
 			}
 		}
 	}
 
-	_initialized = (_glyphs.size() != 0);
+	packGlyphs(images);
+
+	_initialized = loaded;
 	return _initialized;
 }
 
+void TTFFont::packGlyphs(Surface *images) {
+	uint32 atlasSize = 0, spanCount = 0;
+	for (uint i = 0; i < 256; ++i) {
+		atlasSize += images[i].w * images[i].h;
+		spanCount += images[i].h;
+	}
+
+	_atlas = new uint8[MAX<uint32>(atlasSize, 1)];
+	_spans = new GlyphSpan[MAX<uint32>(spanCount, 1)];
+
+	uint8 *dst = _atlas;
+	GlyphSpan *span = _spans;
+
+	for (uint i = 0; i < 256; ++i) {
+		Glyph &glyph = _glyphs[i];
+		Surface &image = images[i];
+
+		glyph.width = image.w;
+		glyph.height = image.h;
+		glyph.atlasOffset = dst - _atlas;
+		glyph.spanOffset = span - _spans;
+
+		for (int y = 0; y < image.h; ++y, ++span) {
+			const uint8 *src = (const uint8 *)image.getBasePtr(0, y);
+			memcpy(dst, src, image.w);
+			dst += image.w;
+
+			int first = 0, last = image.w;
+			while (first < last && !src[first])
+				++first;
+			while (last > first && !src[last - 1])
+				--last;
+
+			span->first = first;
+			span->last = last;
+		}
+
+		image.free();
+	}
+}
+
 int TTFFont::getFontHeight() const {
 	return _height;
 }
@@ -244,11 +337,7 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(byte chr) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return 0;
-	else
-		return glyphEntry->_value.advance;
+	return _glyphs[chr].advance;
 }
 
 int TTFFont::getKerningOffset(byte left, byte right) const {
@@ -268,29 +357,45 @@ int TTFFont::getKerningOffset(byte left, byte right) const {
 
 namespace {
 
+/**
+ * Blends the coverage of a glyph onto the surface. Only the part of each
+ * row inside the row's span is visited, the transparent borders around a
+ * glyph are skipped.
+ */
 template<typename ColorType>
-void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const int srcPitch, const int w, const int h, ColorType color, const PixelFormat &dstFormat) {
+void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const int srcPitch, const GlyphSpan *spans, const int srcX, const int w, const int h, ColorType color, const PixelFormat dstFormat, BlendCache &cache) {
 	uint8 sR, sG, sB;
 	dstFormat.colorToRGB(color, sR, sG, sB);
 
 	for (int y = 0; y < h; ++y) {
-		ColorType *rDst = (ColorType *)dstPos;
-		const uint8 *src = srcPos;
+		const int first = MAX<int>(spans[y].first - srcX, 0);
+		const int last = MIN<int>(spans[y].last - srcX, w);
 
-		for (int x = 0; x < w; ++x) {
+		ColorType *rDst = (ColorType *)dstPos + first;
+		const uint8 *src = srcPos + first;
+
+		for (int x = first; x < last; ++x) {
 			if (*src == 255) {
 				*rDst = color;
 			} else if (*src) {
 				const uint8 a = *src;
-
-				uint8 dR, dG, dB;
-				dstFormat.colorToRGB(*rDst, dR, dG, dB);
-
-				dR = ((255 - a) * dR + a * sR) / 255;
-				dG = ((255 - a) * dG + a * sG) / 255;
-				dB = ((255 - a) * dB + a * sB) / 255;
-
-				*rDst = dstFormat.RGBToColor(dR, dG, dB);
+				const uint idx = (*rDst + a * 37) & 0xFF;
+
+				if (cache.alpha[idx] == a && cache.dst[idx] == *rDst) {
+					*rDst = cache.result[idx];
+				} else {
+					uint8 dR, dG, dB;
+					dstFormat.colorToRGB(*rDst, dR, dG, dB);
+
+					dR = ((255 - a) * dR + a * sR) / 255;
+					dG = ((255 - a) * dG + a * sG) / 255;
+					dB = ((255 - a) * dB + a * sB) / 255;
+
+					cache.alpha[idx] = a;
+					cache.dst[idx] = *rDst;
+					*rDst = dstFormat.RGBToColor(dR, dG, dB);
+					cache.result[idx] = *rDst;
+				}
 			}
 
 			++rDst;
@@ -305,11 +410,7 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return;
-
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = _glyphs[chr];
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -319,14 +420,18 @@ void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.width;
+	int h = glyph.height;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getBasePtr(0, 0);
+	const uint8 *srcPos = _atlas + glyph.atlasOffset;
+	const GlyphSpan *spans = _spans + glyph.spanOffset;
+	const int srcPitch = glyph.width;
+	int srcX = 0;
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
 		srcPos -= x;
+		srcX = -x;
 		w += x;
 		x = 0;
 	}
@@ -338,7 +443,8 @@ void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * srcPitch;
+		spans -= y;
 		h += y;
 		y = 0;
 	}
@@ -353,30 +459,31 @@ void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 
 	if (dst->format.bytesPerPixel == 1) {
 		for (int cy = 0; cy < h; ++cy) {
-			uint8 *rDst = dstPos;
-			const uint8 *src = srcPos;
+			const int first = MAX<int>(spans[cy].first - srcX, 0);
+			const int last = MIN<int>(spans[cy].last - srcX, w);
 
-			for (int cx = 0; cx < w; ++cx) {
+			for (int cx = first; cx < last; ++cx) {
 				// We assume a 1Bpp mode is a color indexed mode, thus we can
 				// not take advantage of anti-aliasing here.
-				if (*src >= 0x80)
-					*rDst = color;
-
-				++rDst;
-				++src;
+				if (srcPos[cx] >= 0x80)
+					dstPos[cx] = color;
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += srcPitch;
 		}
-	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
-	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+	} else {
+		if (_blendCache.color != color || _blendCache.format != dst->format)
+			_blendCache.reset(color, dst->format);
+
+		if (dst->format.bytesPerPixel == 2)
+			renderGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, spans, srcX, w, h, color, dst->format, _blendCache);
+		else if (dst->format.bytesPerPixel == 4)
+			renderGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, spans, srcX, w, h, color, dst->format, _blendCache);
 	}
 }
 
-bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
+bool TTFFont::cacheGlyph(Glyph &glyph, Surface &image, FT_UInt &slot, uint chr) {
 	slot = FT_Get_Char_Index(_face, chr);
 	if (!slot)
 		return false;
@@ -413,7 +520,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
 	}
 
 	const FT_Bitmap &bitmap = _face->glyph->bitmap;
-	glyph.image.create(bitmap.width, bitmap.rows, PixelFormat::createFormatCLUT8());
+	image.create(bitmap.width, bitmap.rows, PixelFormat::createFormatCLUT8());
 
 	const uint8 *src = bitmap.buffer;
 	int srcPitch = bitmap.pitch;
@@ -422,8 +529,8 @@ bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getBasePtr(0, 0);
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
+	uint8 *dst = (uint8 *)image.getBasePtr(0, 0);
+	memset(dst, 0, image.h * image.pitch);
 
 	switch (bitmap.pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
@@ -449,7 +556,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
 	case FT_PIXEL_MODE_GRAY:
 		for (int y = 0; y < bitmap.rows; ++y) {
 			memcpy(dst, src, bitmap.width);
-			dst += glyph.image.pitch;
+			dst += image.pitch;
 			src += srcPitch;
 		}
 		break;
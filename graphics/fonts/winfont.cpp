@@ -48,6 +48,8 @@ void WinFont::close() {
 	_glyphCount = 0;
 	delete[] _glyphs;
 	_glyphs = 0;
+
+	invalidateLayoutCache();
 }
 
 // Reads a null-terminated string
@@ -76,6 +78,8 @@ static WinFontDirEntry readDirEntry(Common::SeekableReadStream &stream) {
 }
 
 bool WinFont::loadFromFON(const Common::String &fileName, const WinFontDirEntry &dirEntry) {
+	invalidateLayoutCache();
+
 	// First try loading via the NE code
 	if (loadFromNE(fileName, dirEntry))
 		return true;
@@ -213,6 +217,9 @@ int WinFont::getCharWidth(byte chr) const {
 }
 
 bool WinFont::loadFromFNT(Common::SeekableReadStream &stream) {
+	// Drop any font loaded before
+	close();
+
 	uint16 version = stream.readUint16LE();
 
 	// We'll accept Win1, Win2, and Win3 fonts
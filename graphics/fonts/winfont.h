@@ -56,6 +56,9 @@ public:
 	/** Open a font from an FNT file */
 	bool loadFromFNT(const Common::String &fileName);
 
+	/** Open a font from an FNT file stream */
+	bool loadFromFNT(Common::SeekableReadStream &stream);
+
 	/** Close this font */
 	void close();
 
@@ -70,7 +73,6 @@ private:
 	bool loadFromNE(const Common::String &fileName, const WinFontDirEntry &dirEntry);
 
 	uint32 getFontIndex(Common::SeekableReadStream &stream, const WinFontDirEntry &dirEntry);
-	bool loadFromFNT(Common::SeekableReadStream &stream);
 	char indexToCharacter(uint16 index) const;
 	uint16 characterToIndex(byte character) const;
 
@@ -26,6 +26,19 @@
 #include "common/scummsys.h"
 #include "graphics/colormasks.h"
 
+// SSE2 is always available on x86-64 and NEON on ARM64, so the hq scalers
+// use them whenever the compiler targets them. Define DISABLE_HQ_SCALER_SIMD
+// to build the plain C version, e.g. to compare both with scalerbench.
+#if defined(DISABLE_HQ_SCALER_SIMD)
+// Use the C version
+#elif defined(__SSE2__)
+#define USE_SSE2_HQ_SCALERS
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define USE_NEON_HQ_SCALERS
+#include <arm_neon.h>
+#endif
+
 
 /**
  * Interpolate two 16 bit pixel *pairs* at once with equal weights 1.
@@ -218,4 +231,71 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 */
 }
 
+/**
+ * Compute the hq scaler pattern of a pixel, i.e. check which of the eight
+ * pixels around it differ from it according to diffYUV(). Bit 0 to 7 of the
+ * result are set for the neighbours 1, 2, 3, 4, 6, 7, 8 and 9:
+ *
+ *	 +----+----+----+
+ *	 | w1 | w2 | w3 |
+ *	 +----+----+----+
+ *	 | w4 | w5 | w6 |
+ *	 +----+----+----+
+ *	 | w7 | w8 | w9 |
+ *	 +----+----+----+
+ */
+static inline int hqPattern(int yuv5, int yuv1, int yuv2, int yuv3, int yuv4, int yuv6, int yuv7, int yuv8, int yuv9) {
+#if defined(USE_SSE2_HQ_SCALERS) || defined(USE_NEON_HQ_SCALERS)
+	// Y, U and V each take one byte, so the per byte absolute differences of
+	// all eight neighbours can be compared to the thresholds of diffYUV() at
+	// once. The highest byte is always zero.
+	static const int thresholds = 0x00300706;
+#endif
+
+#if defined(USE_SSE2_HQ_SCALERS)
+	const __m128i center = _mm_set1_epi32(yuv5);
+	const __m128i threshold = _mm_set1_epi32(thresholds);
+	const __m128i zero = _mm_setzero_si128();
+
+	const __m128i lo = _mm_set_epi32(yuv4, yuv3, yuv2, yuv1);
+	const __m128i hi = _mm_set_epi32(yuv9, yuv8, yuv7, yuv6);
+
+	// |a - b| for unsigned bytes, and whether it exceeds the threshold
+	__m128i diffLo = _mm_or_si128(_mm_subs_epu8(lo, center), _mm_subs_epu8(center, lo));
+	__m128i diffHi = _mm_or_si128(_mm_subs_epu8(hi, center), _mm_subs_epu8(center, hi));
+	diffLo = _mm_cmpeq_epi32(_mm_subs_epu8(diffLo, threshold), zero);
+	diffHi = _mm_cmpeq_epi32(_mm_subs_epu8(diffHi, threshold), zero);
+
+	const int similar = _mm_movemask_ps(_mm_castsi128_ps(diffLo)) | (_mm_movemask_ps(_mm_castsi128_ps(diffHi)) << 4);
+	return similar ^ 0xFF;
+#elif defined(USE_NEON_HQ_SCALERS)
+	const uint32 neighboursLo[4] = { (uint32)yuv1, (uint32)yuv2, (uint32)yuv3, (uint32)yuv4 };
+	const uint32 neighboursHi[4] = { (uint32)yuv6, (uint32)yuv7, (uint32)yuv8, (uint32)yuv9 };
+	static const uint32 bitsLo[4] = { 0x01, 0x02, 0x04, 0x08 };
+	static const uint32 bitsHi[4] = { 0x10, 0x20, 0x40, 0x80 };
+
+	const uint8x16_t center = vreinterpretq_u8_u32(vdupq_n_u32(yuv5));
+	const uint8x16_t threshold = vreinterpretq_u8_u32(vdupq_n_u32(thresholds));
+
+	const uint8x16_t diffLo = vcgtq_u8(vabdq_u8(vreinterpretq_u8_u32(vld1q_u32(neighboursLo)), center), threshold);
+	const uint8x16_t diffHi = vcgtq_u8(vabdq_u8(vreinterpretq_u8_u32(vld1q_u32(neighboursHi)), center), threshold);
+
+	// Turn every lane with a byte over its threshold into the pattern bit
+	const uint32x4_t laneLo = vtstq_u32(vreinterpretq_u32_u8(diffLo), vreinterpretq_u32_u8(diffLo));
+	const uint32x4_t laneHi = vtstq_u32(vreinterpretq_u32_u8(diffHi), vreinterpretq_u32_u8(diffHi));
+	return vaddvq_u32(vorrq_u32(vandq_u32(laneLo, vld1q_u32(bitsLo)), vandq_u32(laneHi, vld1q_u32(bitsHi))));
+#else
+	int pattern = 0;
+	if (yuv5 != yuv1 && diffYUV(yuv5, yuv1)) pattern |= 0x0001;
+	if (yuv5 != yuv2 && diffYUV(yuv5, yuv2)) pattern |= 0x0002;
+	if (yuv5 != yuv3 && diffYUV(yuv5, yuv3)) pattern |= 0x0004;
+	if (yuv5 != yuv4 && diffYUV(yuv5, yuv4)) pattern |= 0x0008;
+	if (yuv5 != yuv6 && diffYUV(yuv5, yuv6)) pattern |= 0x0010;
+	if (yuv5 != yuv7 && diffYUV(yuv5, yuv7)) pattern |= 0x0020;
+	if (yuv5 != yuv8 && diffYUV(yuv5, yuv8)) pattern |= 0x0040;
+	if (yuv5 != yuv9 && diffYUV(yuv5, yuv9)) pattern |= 0x0080;
+	return pattern;
+#endif
+}
+
 #endif
@@ -24,6 +24,7 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -75,6 +76,10 @@ struct WidgetDrawData {
 
 	bool _buffer;
 
+	/** Whether the rendered steps may be kept in the widget cache, i.e. they
+	    depend on the size of the area only and not on its position */
+	bool _cacheable;
+
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -86,6 +91,23 @@ struct WidgetDrawData {
 	void calcBackgroundOffset();
 };
 
+struct WidgetCacheEntry {
+	const WidgetDrawData *data; ///< DrawData item, or 0 for a free entry
+	uint16 width, height;       ///< Size of the widget area
+	uint32 dynamic;
+	bool shadows;
+	uint32 colors[Graphics::VectorRenderer::kColorCount];
+
+	uint32 lastUsed;
+	uint32 size;   ///< Size of each of the pixel buffers
+	byte *before;  ///< Pixels of the extended area before drawing
+	byte *after;   ///< Pixels of the extended area after drawing
+};
+
+enum {
+	kWidgetCacheEntries = 64
+};
+
 class ThemeItem {
 
 public:
@@ -223,11 +245,8 @@ void ThemeItemDrawData::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step)
-			_engine->renderer()->drawStep(_area, *step, _dynamicData);
-	}
+	if (draw)
+		_engine->drawSteps(_data, _area, extendedRect, _dynamicData);
 
 	_engine->addDirtyRect(extendedRect);
 }
@@ -267,9 +286,13 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(0), _vectorRenderer(0),
 	_buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(0) {
+	_widgetCacheSize(0), _widgetCacheBudget(0), _widgetCacheCounter(0), _widgetCacheHits(0), _widgetCacheMisses(0),
+	_themeCacheLoaded(false), _themeCacheDirty(false), _cursor(0) {
 
 	_system = g_system;
+
+	_widgetCache = new WidgetCacheEntry[kWidgetCacheEntries];
+	memset(_widgetCache, 0, sizeof(WidgetCacheEntry) * kWidgetCacheEntries);
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
 
@@ -323,6 +346,10 @@ ThemeEngine::~ThemeEngine() {
 	}
 	_bitmaps.clear();
 
+	clearThemeCache();
+	clearWidgetCache();
+	delete[] _widgetCache;
+
 	delete _parser;
 	delete _themeEval;
 	delete[] _cursor;
@@ -515,10 +542,16 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
+
+	// Allow the widget cache to hold a few screens worth of pixels.
+	clearWidgetCache();
+	_widgetCacheBudget = MAX<uint32>(4 * _screen.pitch * _screen.h, 1024 * 1024);
 }
 
 void WidgetDrawData::calcBackgroundOffset() {
 	uint maxShadow = 0;
+	_cacheable = true;
+
 	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
 	        step != _steps.end(); ++step) {
 		if ((step->autoWidth || step->autoHeight) && step->shadow > maxShadow)
@@ -526,11 +559,145 @@ void WidgetDrawData::calcBackgroundOffset() {
 
 		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_BEVELSQ && step->bevel > maxShadow)
 			maxShadow = step->bevel;
+
+		// Scaled steps are scaled in screen coordinates, and tabs draw
+		// their base line outside of their area.
+		if ((step->scale != (1 << 16) && step->scale != 0)
+		    || step->drawingCall == &Graphics::VectorRenderer::drawCallback_TAB)
+			_cacheable = false;
 	}
 
 	_backgroundOffset = maxShadow;
 }
 
+void ThemeEngine::drawSteps(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedArea, uint32 dynamic) {
+	Graphics::Surface *surface = _vectorRenderer->getSurface();
+	const Common::Rect &r = extendedArea;
+
+	// Only cache widgets which are drawn completely, so the rendering
+	// does not depend on their position on the screen.
+	if (!data->_cacheable || r.left < 0 || r.top < 0 || r.right > surface->w || r.bottom > surface->h || r.isEmpty()) {
+		for (Common::List<Graphics::DrawStep>::const_iterator step = data->_steps.begin(); step != data->_steps.end(); ++step)
+			_vectorRenderer->drawStep(area, *step, dynamic);
+		return;
+	}
+
+	const uint32 rowSize = r.width() * surface->format.bytesPerPixel;
+	const uint32 size = rowSize * r.height();
+
+	uint32 colors[Graphics::VectorRenderer::kColorCount];
+	_vectorRenderer->getColors(colors);
+	const bool shadows = _vectorRenderer->shadowsEnabled();
+
+	WidgetCacheEntry *entry = 0;
+	WidgetCacheEntry *slot = 0;
+
+	for (int i = 0; i < kWidgetCacheEntries; ++i) {
+		WidgetCacheEntry &e = _widgetCache[i];
+
+		if (!e.data) {
+			if (!slot || slot->data)
+				slot = &e;
+			continue;
+		}
+
+		if (!slot || (slot->data && e.lastUsed < slot->lastUsed))
+			slot = &e;
+
+		if (e.data != data || e.width != area.width() || e.height != area.height() || e.dynamic != dynamic
+		    || e.shadows != shadows || memcmp(e.colors, colors, sizeof(colors)))
+			continue;
+
+		// The steps may blend with the pixels below, e.g. for rounded
+		// corners and shadows, so these must match, too.
+		const byte *before = e.before;
+		int y;
+		for (y = r.top; y < r.bottom; ++y, before += rowSize) {
+			if (memcmp(surface->getBasePtr(r.left, y), before, rowSize))
+				break;
+		}
+
+		if (y == r.bottom) {
+			entry = &e;
+			break;
+		}
+	}
+
+	if (entry) {
+		const byte *after = entry->after;
+		for (int y = r.top; y < r.bottom; ++y, after += rowSize)
+			memcpy(surface->getBasePtr(r.left, y), after, rowSize);
+
+		// Leave the renderer in the same state as drawing would.
+		for (Common::List<Graphics::DrawStep>::const_iterator step = data->_steps.begin(); step != data->_steps.end(); ++step)
+			_vectorRenderer->setStepColors(*step);
+
+		entry->lastUsed = ++_widgetCacheCounter;
+		++_widgetCacheHits;
+		return;
+	}
+
+	++_widgetCacheMisses;
+
+	// Widgets which would take up most of the cache are not worth it.
+	const bool store = 2 * size <= _widgetCacheBudget / 2;
+
+	if (store) {
+		// Free the least recently used entries until the new one fits.
+		if (slot->data)
+			freeWidgetCacheEntry(*slot);
+
+		while (_widgetCacheSize + 2 * size > _widgetCacheBudget) {
+			WidgetCacheEntry *oldest = 0;
+			for (int i = 0; i < kWidgetCacheEntries; ++i) {
+				if (_widgetCache[i].data && (!oldest || _widgetCache[i].lastUsed < oldest->lastUsed))
+					oldest = &_widgetCache[i];
+			}
+
+			freeWidgetCacheEntry(*oldest);
+		}
+
+		slot->data = data;
+		slot->width = area.width();
+		slot->height = area.height();
+		slot->dynamic = dynamic;
+		slot->shadows = shadows;
+		memcpy(slot->colors, colors, sizeof(colors));
+		slot->lastUsed = ++_widgetCacheCounter;
+		slot->size = size;
+		slot->before = (byte *)malloc(size);
+		slot->after = (byte *)malloc(size);
+		_widgetCacheSize += 2 * size;
+
+		byte *before = slot->before;
+		for (int y = r.top; y < r.bottom; ++y, before += rowSize)
+			memcpy(before, surface->getBasePtr(r.left, y), rowSize);
+	}
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = data->_steps.begin(); step != data->_steps.end(); ++step)
+		_vectorRenderer->drawStep(area, *step, dynamic);
+
+	if (store) {
+		byte *after = slot->after;
+		for (int y = r.top; y < r.bottom; ++y, after += rowSize)
+			memcpy(after, surface->getBasePtr(r.left, y), rowSize);
+	}
+}
+
+void ThemeEngine::freeWidgetCacheEntry(WidgetCacheEntry &entry) {
+	free(entry.before);
+	free(entry.after);
+	_widgetCacheSize -= 2 * entry.size;
+	memset(&entry, 0, sizeof(entry));
+}
+
+void ThemeEngine::clearWidgetCache() {
+	for (int i = 0; i < kWidgetCacheEntries; ++i) {
+		if (_widgetCache[i].data)
+			freeWidgetCacheEntry(_widgetCache[i]);
+	}
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	r.clip(_screen.w, _screen.h);
 	_vectorRenderer->blitSurface(&_backBuffer, r);
@@ -640,8 +807,10 @@ bool ThemeEngine::addBitmap(const Common::String &filename) {
 		}
 	}
 
-	if (srcSurface && srcSurface->format.bytesPerPixel != 1)
+	if (srcSurface && srcSurface->format.bytesPerPixel != 1) {
 		surf = srcSurface->convertTo(_overlayFormat);
+		_themeCacheDirty = true;
+	}
 
 	// Store the surface into our hashmap (attention, may store NULL entries!)
 	_bitmaps[filename] = surf;
@@ -660,6 +829,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_buffer = kDrawDataDefaults[id].buffer;
+	_widgets[id]->_cacheable = false;
 	_widgets[id]->_textDataId = kTextDataNone;
 
 	return true;
@@ -674,6 +844,11 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 
 	debug(6, "Loading theme %s", themeId.c_str());
 
+	if (!_themeCacheLoaded) {
+		_themeCacheLoaded = true;
+		loadThemeCache();
+	}
+
 	if (themeId == "builtin") {
 		_themeOk = loadDefaultXML();
 	} else {
@@ -693,6 +868,9 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			_widgets[i]->calcBackgroundOffset();
 		}
 	}
+
+	if (_themeCacheDirty)
+		saveThemeCache();
 }
 
 void ThemeEngine::unloadTheme() {
@@ -714,32 +892,32 @@ void ThemeEngine::unloadTheme() {
 		_textColors[i] = 0;
 	}
 
+	clearWidgetCache();
+
 	_themeEval->reset();
 	_themeOk = false;
 }
 
-bool ThemeEngine::loadDefaultXML() {
-
-	// The default XML theme is included on runtime from a pregenerated
-	// file inside the themes directory.
-	// Use the Python script "makedeftheme.py" to convert a normal XML theme
-	// into the "default.inc" file, which is ready to be included in the code.
+// The default XML theme is included on runtime from a pregenerated
+// file inside the themes directory.
+// Use the Python script "makedeftheme.py" to convert a normal XML theme
+// into the "default.inc" file, which is ready to be included in the code.
 #ifndef DISABLE_GUI_BUILTIN_THEME
-	const char *defaultXML =
+static const char *const defaultXML =
 #include "themes/default.inc"
-	    ;
-
-	if (!_parser->loadBuffer((const byte *)defaultXML, strlen(defaultXML)))
-		return false;
+    ;
+#endif
 
+bool ThemeEngine::loadDefaultXML() {
+#ifndef DISABLE_GUI_BUILTIN_THEME
 	_themeName = "ScummVM Classic Theme (Builtin Version)";
 	_themeId = "builtin";
 	_themeFile.clear();
 
-	bool result = _parser->parse();
-	_parser->close();
+	if (_compiledStx.contains("default.inc"))
+		return parseCompiledStx("default.inc");
 
-	return result;
+	return parseStx("default.inc", new Common::MemoryReadStream((const byte *)defaultXML, strlen(defaultXML)));
 #else
 	warning("The built-in theme is not enabled in the current build. Please load an external theme");
 	return false;
@@ -781,25 +959,338 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
-		if (_parser->loadStream((*i)->createReadStream()) == false) {
+		const Common::String name = (*i)->getName();
+		if (_compiledStx.contains(name)) {
+			if (!parseCompiledStx(name)) {
+				warning("Failed to parse compiled STX file '%s'", (*i)->getDisplayName().c_str());
+				return false;
+			}
+
+			continue;
+		}
+
+		Common::SeekableReadStream *stream = (*i)->createReadStream();
+		if (!stream) {
 			warning("Failed to load STX file '%s'", (*i)->getDisplayName().c_str());
-			_parser->close();
 			return false;
 		}
 
-		if (_parser->parse() == false) {
+		if (!parseStx(name, stream)) {
 			warning("Failed to parse STX file '%s'", (*i)->getDisplayName().c_str());
-			_parser->close();
 			return false;
 		}
-
-		_parser->close();
 	}
 
 	assert(!_themeName.empty());
 	return true;
 }
 
+bool ThemeEngine::parseStx(const Common::String &name, Common::SeekableReadStream *stream) {
+	Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::NO);
+
+	_parser->loadStream(stream);
+	_parser->setCompiledOutput(&compiled);
+	bool result = _parser->parse();
+	_parser->setCompiledOutput(0);
+	_parser->close();
+
+	if (!result) {
+		free(compiled.getData());
+		return false;
+	}
+
+	CompiledStx stx;
+	stx.data = compiled.getData();
+	stx.size = compiled.size();
+	_compiledStx[name] = stx;
+	_themeCacheDirty = true;
+
+	return true;
+}
+
+bool ThemeEngine::parseCompiledStx(const Common::String &name) {
+	const CompiledStx &stx = _compiledStx[name];
+
+	_parser->loadBuffer(stx.data, stx.size);
+	bool result = _parser->parseCompiled();
+	_parser->close();
+
+	// The compiled key streams are only produced from STX files which
+	// parsed fine, so this means the cache is broken. Throw it away so
+	// the next attempt parses the sources again.
+	if (!result) {
+		clearThemeCache();
+		_themeCacheDirty = true;
+	}
+
+	return result;
+}
+
+
+/**********************************************************
+ * Theme cache
+ *********************************************************/
+#define THEME_CACHE_TAG MKTAG('S', 'T', 'H', 'C')
+#define THEME_CACHE_VERSION 2
+#define THEME_CACHE_HASH_INIT 2166136261u
+
+static uint32 hashThemeData(const void *data, uint32 size, uint32 hash) {
+	// FNV-1a
+	for (uint32 i = 0; i < size; ++i)
+		hash = (hash ^ ((const byte *)data)[i]) * 16777619;
+
+	return hash;
+}
+
+static uint32 hashThemeFile(const Common::String &name, Common::SeekableReadStream *stream, uint32 hash) {
+	hash = hashThemeData(name.c_str(), name.size(), hash);
+	if (!stream)
+		return hash;
+
+	// The contents are hashed, so that edited files are noticed even when
+	// their size stays the same
+	byte buffer[4096];
+	uint32 size;
+	while ((size = stream->read(buffer, sizeof(buffer))) > 0)
+		hash = hashThemeData(buffer, size, hash);
+
+	return hash;
+}
+
+uint32 ThemeEngine::calcThemeCacheKey() const {
+	uint32 key = THEME_CACHE_HASH_INIT;
+
+	if (_themeFile.empty()) {
+#ifndef DISABLE_GUI_BUILTIN_THEME
+		key = hashThemeData(defaultXML, strlen(defaultXML), key);
+#endif
+		return key;
+	}
+
+	Common::FSNode node(_themeFile);
+	if (node.isDirectory()) {
+		// Sum up the keys of the single files, so the key does not
+		// depend on the order the archive lists its members in.
+		Common::ArchiveMemberList members;
+		_themeArchive->listMembers(members);
+
+		uint32 sum = 0;
+		for (Common::ArchiveMemberList::const_iterator i = members.begin(); i != members.end(); ++i) {
+			Common::SeekableReadStream *stream = (*i)->createReadStream();
+			sum += hashThemeFile((*i)->getName(), stream, key);
+			delete stream;
+		}
+
+		return sum;
+	}
+
+	Common::SeekableReadStream *stream = 0;
+	Common::ArchiveMemberPtr member = SearchMan.getMember(_themeFile);
+	if (member)
+		stream = member->createReadStream();
+	else
+		stream = node.createReadStream();
+
+	key = hashThemeFile(_themeFile, stream, key);
+	delete stream;
+
+	return key;
+}
+
+Common::FSNode ThemeEngine::getThemeCacheFile() const {
+	Common::String configFileName = ConfMan.getConfigFileName();
+	if (configFileName.empty())
+		configFileName = _system->getDefaultConfigFileName();
+
+	// Keep the cache next to the config file, and hidden if that is
+	const Common::FSNode configFile(configFileName);
+	const Common::String prefix = configFile.getName().hasPrefix(".") ? ".scummvm-theme-" : "scummvm-theme-";
+	return configFile.getParent().getChild(prefix + _themeId + ".stc");
+}
+
+static void writePixelFormat(Common::WriteStream &stream, const Graphics::PixelFormat &format) {
+	stream.writeByte(format.bytesPerPixel);
+	stream.writeByte(format.rLoss);
+	stream.writeByte(format.gLoss);
+	stream.writeByte(format.bLoss);
+	stream.writeByte(format.aLoss);
+	stream.writeByte(format.rShift);
+	stream.writeByte(format.gShift);
+	stream.writeByte(format.bShift);
+	stream.writeByte(format.aShift);
+#ifdef SCUMM_BIG_ENDIAN
+	stream.writeByte(1);
+#else
+	stream.writeByte(0);
+#endif
+}
+
+void ThemeEngine::loadThemeCache() {
+	const Common::FSNode cacheFile = getThemeCacheFile();
+	const Common::String filename = cacheFile.getPath();
+	Common::SeekableReadStream *file = cacheFile.exists() ? cacheFile.createReadStream() : 0;
+	if (!file) {
+		_themeCacheDirty = true;
+		return;
+	}
+
+	// Read the whole cache in one go and parse it from memory.
+	const uint32 fileSize = file->size();
+	byte *data = (byte *)malloc(fileSize);
+	const bool readOk = data && file->read(data, fileSize) == fileSize;
+	delete file;
+
+	if (!readOk) {
+		free(data);
+		_themeCacheDirty = true;
+		return;
+	}
+
+	// A cache which was only partly written doesn't match its checksum
+	if (fileSize < 4 || READ_BE_UINT32(data + fileSize - 4) != hashThemeData(data, fileSize - 4, THEME_CACHE_HASH_INIT)) {
+		warning("Theme cache '%s' is corrupted", filename.c_str());
+		free(data);
+		_themeCacheDirty = true;
+		return;
+	}
+
+	Common::MemoryReadStream stream(data, fileSize - 4, DisposeAfterUse::YES);
+
+	if (stream.readUint32BE() != THEME_CACHE_TAG || stream.readUint32BE() != THEME_CACHE_VERSION
+	    || stream.readUint32BE() != calcThemeCacheKey()) {
+		debug(3, "Theme cache '%s' is outdated", filename.c_str());
+		_themeCacheDirty = true;
+		return;
+	}
+
+	// Bitmaps are only usable when they were converted for the same
+	// overlay format. The compiled STX files do not depend on it.
+	Common::MemoryWriteStreamDynamic format(DisposeAfterUse::YES);
+	writePixelFormat(format, _overlayFormat);
+
+	byte cachedFormat[16];
+	assert(format.size() <= sizeof(cachedFormat));
+	stream.read(cachedFormat, format.size());
+	const bool formatOk = !memcmp(cachedFormat, format.getData(), format.size());
+
+	uint32 count = stream.readUint32BE();
+	while (count-- && !stream.err() && !stream.eos()) {
+		const Common::String name = stream.readLine();
+		const uint32 size = stream.readUint32BE();
+
+		CompiledStx stx;
+		stx.data = (byte *)malloc(size);
+		stx.size = size;
+
+		if (!stx.data || stream.read(stx.data, size) != size) {
+			free(stx.data);
+			break;
+		}
+
+		if (_compiledStx.contains(name))
+			free(_compiledStx[name].data);
+		_compiledStx[name] = stx;
+	}
+
+	count = stream.readUint32BE();
+	while (count-- && !stream.err() && !stream.eos()) {
+		const Common::String name = stream.readLine();
+		const uint16 w = stream.readUint16BE();
+		const uint16 h = stream.readUint16BE();
+		const uint32 size = w * h * _overlayFormat.bytesPerPixel;
+
+		if (!formatOk || _bitmaps.contains(name)) {
+			stream.skip(size);
+			continue;
+		}
+
+		Graphics::Surface *surf = new Graphics::Surface();
+		surf->create(w, h, _overlayFormat);
+
+		byte *dst = (byte *)surf->pixels;
+		for (uint y = 0; y < h; ++y, dst += surf->pitch)
+			stream.read(dst, w * _overlayFormat.bytesPerPixel);
+
+		_bitmaps[name] = surf;
+	}
+
+	if (stream.err() || stream.eos()) {
+		warning("Theme cache '%s' is corrupted", filename.c_str());
+		clearThemeCache();
+		_themeCacheDirty = true;
+		return;
+	}
+
+	_themeCacheDirty = !formatOk;
+}
+
+void ThemeEngine::saveThemeCache() {
+	_themeCacheDirty = false;
+
+	// The cache is put together in memory first, so that a checksum of the
+	// whole cache can be appended to it
+	Common::MemoryWriteStreamDynamic cache(DisposeAfterUse::YES);
+
+	cache.writeUint32BE(THEME_CACHE_TAG);
+	cache.writeUint32BE(THEME_CACHE_VERSION);
+	cache.writeUint32BE(calcThemeCacheKey());
+	writePixelFormat(cache, _overlayFormat);
+
+	cache.writeUint32BE(_compiledStx.size());
+	for (CompiledStxMap::const_iterator i = _compiledStx.begin(); i != _compiledStx.end(); ++i) {
+		cache.writeString(i->_key);
+		cache.writeByte('\n');
+		cache.writeUint32BE(i->_value.size);
+		cache.write(i->_value.data, i->_value.size);
+	}
+
+	uint32 bitmaps = 0;
+	for (ImagesMap::const_iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
+		if (i->_value && i->_value->format == _overlayFormat)
+			++bitmaps;
+	}
+
+	cache.writeUint32BE(bitmaps);
+	for (ImagesMap::const_iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
+		const Graphics::Surface *surf = i->_value;
+		if (!surf || surf->format != _overlayFormat)
+			continue;
+
+		cache.writeString(i->_key);
+		cache.writeByte('\n');
+		cache.writeUint16BE(surf->w);
+		cache.writeUint16BE(surf->h);
+
+		const byte *src = (const byte *)surf->pixels;
+		for (int y = 0; y < surf->h; ++y, src += surf->pitch)
+			cache.write(src, surf->w * surf->format.bytesPerPixel);
+	}
+
+	cache.writeUint32BE(hashThemeData(cache.getData(), cache.size(), THEME_CACHE_HASH_INIT));
+
+	const Common::FSNode cacheFile = getThemeCacheFile();
+	const Common::String filename = cacheFile.getPath();
+	Common::WriteStream *stream = cacheFile.createWriteStream();
+	if (!stream) {
+		debug(3, "Couldn't open theme cache '%s' for writing", filename.c_str());
+		return;
+	}
+
+	stream->write(cache.getData(), cache.size());
+	stream->finalize();
+	if (stream->err())
+		warning("Couldn't write theme cache '%s'", filename.c_str());
+
+	delete stream;
+}
+
+void ThemeEngine::clearThemeCache() {
+	for (CompiledStxMap::iterator i = _compiledStx.begin(); i != _compiledStx.end(); ++i)
+		free(i->_value.data);
+
+	_compiledStx.clear();
+}
+
 
 
 /**********************************************************
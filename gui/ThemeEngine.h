@@ -41,6 +41,7 @@ class OSystem;
 
 namespace Common {
 struct Rect;
+class SeekableReadStream;
 }
 
 namespace Graphics {
@@ -51,6 +52,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+struct WidgetCacheEntry;
 struct TextDrawData;
 struct TextColorData;
 class Dialog;
@@ -505,6 +507,23 @@ public:
 	 */
 	bool createCursor(const Common::String &filename, int hotspotX, int hotspotY);
 
+	/**
+	 * Draws the steps of a DrawData item on the active surface of the
+	 * renderer. Renderings are kept in the widget cache, keyed by the
+	 * DrawData item, the size of the area, the dynamic data, the renderer
+	 * state and the pixels below, so drawing the same widget again over
+	 * the same background only copies the cached pixels.
+	 *
+	 * @param data DrawData item to draw.
+	 * @param area Area of the widget.
+	 * @param extendedArea Area including shadows, which all steps stay in.
+	 * @param dynamic Dynamic data passed to the steps.
+	 */
+	void drawSteps(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedArea, uint32 dynamic);
+
+	uint32 getWidgetCacheHits() const { return _widgetCacheHits; }
+	uint32 getWidgetCacheMisses() const { return _widgetCacheMisses; }
+
 	/**
 	 * Wrapper for restoring data from the Back Buffer to the screen.
 	 * The actual processing is done in the VectorRenderer.
@@ -549,6 +568,44 @@ protected:
 	 */
 	void unloadTheme();
 
+	/**
+	 * Parses one STX file of the theme from its source. While parsing,
+	 * the keys are recorded into a compiled key stream which is kept for
+	 * the theme cache.
+	 */
+	bool parseStx(const Common::String &name, Common::SeekableReadStream *stream);
+
+	/**
+	 * Parses one STX file of the theme from its compiled key stream.
+	 */
+	bool parseCompiledStx(const Common::String &name);
+
+	/**
+	 * Loads the theme cache, which stores the compiled key stream of every
+	 * STX file and every bitmap already converted to the overlay format,
+	 * so that loading the theme skips both the XML tokenizer and the
+	 * bitmap decoder. The cache is stored next to the config file, and
+	 * ends with a checksum so that partly written caches are rejected.
+	 */
+	void loadThemeCache();
+
+	/**
+	 * Writes the theme cache, if anything was parsed or decoded since it
+	 * was loaded.
+	 */
+	void saveThemeCache();
+
+	/** Frees all the compiled key streams. */
+	void clearThemeCache();
+
+	/**
+	 * Calculates the key identifying the sources of the current theme from
+	 * the names and contents of its files. Zipped themes are hashed as a
+	 * whole, without inflating them.
+	 */
+	uint32 calcThemeCacheKey() const;
+	Common::FSNode getThemeCacheFile() const;
+
 	const Graphics::Font *loadScalableFont(const Common::String &filename, const Common::String &charset, const int pointsize, Common::String &name);
 	const Graphics::Font *loadFont(const Common::String &filename, Common::String &name);
 	Common::String genCacheFilename(const Common::String &filename) const;
@@ -673,6 +730,27 @@ protected:
 	Common::Archive *_themeArchive;
 	Common::SearchSet _themeFiles;
 
+	WidgetCacheEntry *_widgetCache; ///< Rendered DrawData items, see drawSteps()
+	uint32 _widgetCacheSize;   ///< Bytes used by the widget cache
+	uint32 _widgetCacheBudget; ///< Bytes the widget cache may use
+	uint32 _widgetCacheCounter;
+	uint32 _widgetCacheHits, _widgetCacheMisses;
+
+	/** Frees all entries of the widget cache. */
+	void clearWidgetCache();
+	void freeWidgetCacheEntry(WidgetCacheEntry &entry);
+
+	struct CompiledStx {
+		byte *data;
+		uint32 size;
+	};
+
+	typedef Common::HashMap<Common::String, CompiledStx, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> CompiledStxMap;
+
+	CompiledStxMap _compiledStx; ///< Compiled key streams of the theme's STX files
+	bool _themeCacheLoaded; ///< Whether the theme cache was already read
+	bool _themeCacheDirty;  ///< Whether the theme cache needs to be written
+
 	bool _useCursor;
 	int _cursorHotspotX, _cursorHotspotY;
 	enum {
@@ -215,6 +215,10 @@ void GuiManager::redraw() {
 	if (_redrawStatus == kRedrawOpenDialog && _dialogStack.size() > 2)
 		shading = ThemeEngine::kShadingNone;
 
+	const uint32 startTime = _system->getMillis();
+	const uint32 cacheHits = _theme->getWidgetCacheHits();
+	const uint32 cacheMisses = _theme->getWidgetCacheMisses();
+
 	switch (_redrawStatus) {
 		case kRedrawCloseDialog:
 		case kRedrawFull:
@@ -241,6 +245,11 @@ void GuiManager::redraw() {
 	}
 
 	_theme->updateScreen();
+
+	debug(5, "GuiManager::redraw: Redrawing dialog '%s' (status %d) took %d ms, widget cache: %d hits, %d misses",
+	      _dialogStack.top()->_name.c_str(), _redrawStatus, _system->getMillis() - startTime,
+	      _theme->getWidgetCacheHits() - cacheHits, _theme->getWidgetCacheMisses() - cacheMisses);
+
 	_redrawStatus = kRedrawDisabled;
 }
 
@@ -21,6 +21,7 @@
 
 #include "base/version.h"
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/fs.h"
@@ -722,11 +723,64 @@ void LauncherDialog::close() {
 	Dialog::close();
 }
 
+namespace {
+
+struct LauncherEntry {
+	Common::String description;
+	Common::String target;
+
+	LauncherEntry(const Common::String &d, const Common::String &t) : description(d), target(t) {}
+};
+
+bool launcherEntryLess(const Common::String &description1, const Common::String &target1, const Common::String &description2, const Common::String &target2) {
+	const int cmp = scumm_stricmp(description1.c_str(), description2.c_str());
+	return cmp < 0 || (cmp == 0 && target1 < target2);
+}
+
+struct LauncherEntryLess {
+	bool operator()(const LauncherEntry &x, const LauncherEntry &y) const {
+		return launcherEntryLess(x.description, x.target, y.description, y.target);
+	}
+};
+
+/**
+ * Get the text shown in the launcher for a target. Looking up the
+ * description of the game id is slow, so callers can pass a map to
+ * remember those results in.
+ */
+Common::String describeTarget(const Common::String &target, const ConfigManager::Domain &domain, Common::StringMap *gameDescriptions) {
+	Common::String gameid(domain.getVal("gameid"));
+	Common::String description(domain.getVal("description"));
+
+	if (gameid.empty())
+		gameid = target;
+	if (description.empty()) {
+		if (gameDescriptions && gameDescriptions->contains(gameid)) {
+			description = (*gameDescriptions)[gameid];
+		} else {
+			GameDescriptor g = EngineMan.findGame(gameid);
+			if (g.contains("description"))
+				description = g.description();
+
+			if (gameDescriptions)
+				(*gameDescriptions)[gameid] = description;
+		}
+	}
+
+	if (description.empty()) {
+		description = Common::String::format("Unknown (target %s, gameid %s)", target.c_str(), gameid.c_str());
+	}
+
+	return description;
+}
+
+} // End of anonymous namespace
+
 void LauncherDialog::updateListing() {
-	StringArray l;
+	Common::Array<LauncherEntry> entries;
+	Common::StringMap gameDescriptions;
 
 	// Retrieve a list of all games defined in the config file
-	_domains.clear();
 	const ConfigManager::DomainMap &domains = ConfMan.getGameDomains();
 	ConfigManager::DomainMap::const_iterator iter;
 	for (iter = domains.begin(); iter != domains.end(); ++iter) {
@@ -738,35 +792,51 @@ void LauncherDialog::updateListing() {
 		}
 #endif
 
-		String gameid(iter->_value.getVal("gameid"));
-		String description(iter->_value.getVal("description"));
+		entries.push_back(LauncherEntry(describeTarget(iter->_key, iter->_value, &gameDescriptions), iter->_key));
+	}
 
-		if (gameid.empty())
-			gameid = iter->_key;
-		if (description.empty()) {
-			GameDescriptor g = EngineMan.findGame(gameid);
-			if (g.contains("description"))
-				description = g.description();
-		}
+	Common::sort(entries.begin(), entries.end(), LauncherEntryLess());
 
-		if (description.empty()) {
-			description = Common::String::format("Unknown (target %s, gameid %s)", iter->_key.c_str(), gameid.c_str());
-		}
+	_domains.resize(entries.size());
+	_descriptions.resize(entries.size());
+	for (uint i = 0; i < entries.size(); ++i) {
+		_domains[i] = entries[i].target;
+		_descriptions[i] = entries[i].description;
+	}
 
-		if (!gameid.empty() && !description.empty()) {
-			// Insert the game into the launcher list
-			int pos = 0, size = l.size();
+	updateListWidget();
+}
 
-			while (pos < size && (scumm_stricmp(description.c_str(), l[pos].c_str()) > 0))
-				pos++;
-			l.insert_at(pos, description);
-			_domains.insert_at(pos, iter->_key);
-		}
+void LauncherDialog::addEntry(const String &target) {
+	const ConfigManager::Domain *domain = ConfMan.getDomain(target);
+	if (!domain)
+		return;
+
+	const String description = describeTarget(target, *domain, 0);
+
+	// Binary search for the insert position
+	uint first = 0, last = _domains.size();
+	while (first < last) {
+		const uint mid = (first + last) / 2;
+		if (launcherEntryLess(_descriptions[mid], _domains[mid], description, target))
+			first = mid + 1;
+		else
+			last = mid;
 	}
 
+	_domains.insert_at(first, target);
+	_descriptions.insert_at(first, description);
+}
+
+void LauncherDialog::removeEntry(int item) {
+	_domains.remove_at(item);
+	_descriptions.remove_at(item);
+}
+
+void LauncherDialog::updateListWidget() {
 	const int oldSel = _list->getSelected();
-	_list->setList(l);
-	if (oldSel < (int)l.size())
+	_list->setList(_descriptions);
+	if (oldSel < (int)_descriptions.size())
 		_list->setSelected(oldSel);	// Restore the old selection
 	else if (oldSel != -1)
 		// Select the last entry if the list has been reduced
@@ -881,7 +951,8 @@ void LauncherDialog::addGame() {
 					ConfMan.flushToDisk();
 
 					// Update the ListWidget, select the new item, and force a redraw
-					updateListing();
+					addEntry(editDialog.getDomain());
+					updateListWidget();
 					selectTarget(editDialog.getDomain());
 					draw();
 				} else {
@@ -945,7 +1016,8 @@ void LauncherDialog::removeGame(int item) {
 		ConfMan.flushToDisk();
 
 		// Update the ListWidget and force a redraw
-		updateListing();
+		removeEntry(item);
+		updateListWidget();
 		draw();
 	}
 }
@@ -968,8 +1040,11 @@ void LauncherDialog::editGame(int item) {
 		// Write config to disk
 		ConfMan.flushToDisk();
 
-		// Update the ListWidget, reselect the edited game and force a redraw
-		updateListing();
+		// Update the ListWidget, reselect the edited game and force a redraw.
+		// The target may have been renamed, so it is removed and added anew.
+		removeEntry(item);
+		addEntry(editDialog.getDomain());
+		updateListWidget();
 		selectTarget(editDialog.getDomain());
 		draw();
 	}
@@ -66,6 +66,7 @@ protected:
 	StaticTextWidget	*_searchDesc;
 	ButtonWidget	*_searchClearButton;
 	StringArray		_domains;
+	StringArray		_descriptions;	///< Sorted list entries, _domains holds the matching targets
 	BrowserDialog	*_browser;
 	SaveLoadChooser	*_loadDialog;
 
@@ -79,6 +80,20 @@ protected:
 	 */
 	void updateListing();
 
+	/**
+	 * Insert the given target into the sorted list entries, or remove the
+	 * entry with the given index. Both only update the entries, call
+	 * updateListWidget() afterwards.
+	 */
+	void addEntry(const String &target);
+	void removeEntry(int item);
+
+	/**
+	 * Pass the list entries to the list widget, keeping the selection and
+	 * the search filter.
+	 */
+	void updateListWidget();
+
 	void updateButtons();
 
 	void open();
@@ -22,6 +22,8 @@
 #include "gui/saveload-dialog.h"
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/savefile.h"
+#include "common/system.h"
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
@@ -30,8 +32,59 @@
 
 #include "graphics/scaler.h"
 
+namespace Common {
+DECLARE_SINGLETON(GUI::SaveMetaIndex);
+}
+
 namespace GUI {
 
+SaveMetaIndex::SaveMetaIndex() : _changeCount(g_system->getSavefileManager()->getChangeCount()) {
+}
+
+void SaveMetaIndex::checkChangeCount() {
+	// Any savefile written or removed since the entries were stored may
+	// belong to any slot of any target
+	const uint32 changeCount = g_system->getSavefileManager()->getChangeCount();
+	if (changeCount != _changeCount) {
+		_targets.clear();
+		_changeCount = changeCount;
+	}
+}
+
+const SaveStateDescriptor *SaveMetaIndex::find(const Common::String &target, const SaveStateDescriptor &listed) {
+	checkChangeCount();
+
+	TargetMap::const_iterator t = _targets.find(target);
+	if (t == _targets.end())
+		return 0;
+
+	SlotMap::const_iterator i = t->_value.find(listed.getSaveSlot());
+	if (i == t->_value.end() || i->_value.listedDescription != listed.getDescription())
+		return 0;
+
+	return &i->_value.desc;
+}
+
+void SaveMetaIndex::store(const Common::String &target, const SaveStateDescriptor &listed, const SaveStateDescriptor &desc) {
+	checkChangeCount();
+
+	Entry &entry = _targets[target][listed.getSaveSlot()];
+	entry.listedDescription = listed.getDescription();
+	entry.desc = desc;
+
+	// Convert the thumbnail once here instead of every time a widget shows it
+	const Graphics::Surface *thumb = desc.getThumbnail();
+	const Graphics::PixelFormat &requiredFormat = g_gui.theme()->getPixelFormat();
+	if (thumb && thumb->format != requiredFormat)
+		entry.desc.setThumbnail(thumb->convertTo(requiredFormat));
+}
+
+void SaveMetaIndex::invalidate(const Common::String &target, int slot) {
+	TargetMap::iterator t = _targets.find(target);
+	if (t != _targets.end())
+		t->_value.erase(slot);
+}
+
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 SaveLoadChooserType getRequestedSaveLoadDialog(const MetaEngine &metaEngine) {
 	const Common::String &userConfig = ConfMan.get("gui_saveload_chooser", Common::ConfigManager::kApplicationDomain);
@@ -107,6 +160,21 @@ int SaveLoadChooserDialog::run(const Common::String &target, const MetaEngine *m
 	return runIntern();
 }
 
+SaveStateDescriptor SaveLoadChooserDialog::querySaveMetaInfos(const SaveStateDescriptor &listed) {
+	const SaveStateDescriptor *indexed = SaveMetaIndex::instance().find(_target, listed);
+	if (indexed)
+		return *indexed;
+
+	SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), listed.getSaveSlot());
+	SaveMetaIndex::instance().store(_target, listed, desc);
+	return desc;
+}
+
+void SaveLoadChooserDialog::removeSaveState(int slot) {
+	_metaEngine->removeSaveState(_target.c_str(), slot);
+	SaveMetaIndex::instance().invalidate(_target, slot);
+}
+
 void SaveLoadChooserDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 	switch (cmd) {
@@ -274,7 +342,7 @@ void SaveLoadChooserSimple::handleCommand(CommandSender *sender, uint32 cmd, uin
 			MessageDialog alert(_("Do you really want to delete this savegame?"),
 								_("Delete"), _("Cancel"));
 			if (alert.runModal() == kMessageOK) {
-				_metaEngine->removeSaveState(_target.c_str(), _saveList[selItem].getSaveSlot());
+				removeSaveState(_saveList[selItem].getSaveSlot());
 
 				setResult(-1);
 				_list->setSelected(-1);
@@ -360,7 +428,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot());
+		SaveStateDescriptor desc = querySaveMetaInfos(_saveList[selItem]);
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag();
@@ -616,6 +684,19 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 	}
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	if (!_pendingButtons.empty()) {
+		const uint curNum = _pendingButtons.remove_at(0);
+		const SaveStateDescriptor &listed = _saveList[_curPage * _entriesPerPage + curNum];
+
+		SlotButton &curButton = _buttons[curNum];
+		updateSlotButton(curButton, querySaveMetaInfos(listed), true);
+		curButton.container->draw();
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
@@ -836,6 +917,7 @@ void SaveLoadChooserGrid::destroyButtons() {
 	}
 
 	_buttons.clear();
+	_pendingButtons.clear();
 }
 
 void SaveLoadChooserGrid::hideButtons() {
@@ -843,58 +925,25 @@ void SaveLoadChooserGrid::hideButtons() {
 		i->button->setGfx(0);
 		i->setVisible(false);
 	}
+
+	_pendingButtons.clear();
 }
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
+		const SaveStateDescriptor *indexed = SaveMetaIndex::instance().find(_target, _saveList[i]);
 
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
+		if (indexed) {
+			updateSlotButton(curButton, *indexed, true);
 		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
-
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
-
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
-
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
+			// Show what listSaves() told us until handleTickle() gets to
+			// this slot
+			updateSlotButton(curButton, _saveList[i], false);
+			_pendingButtons.push_back(curNum);
 		}
 	}
 
@@ -912,6 +961,52 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &button, const SaveStateDescriptor &desc, bool loaded) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		button.button->setGfx(thumbnail);
+	} else {
+		button.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	button.description->setLabel(Common::String::format("%d. %s", desc.getSaveSlot(), desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	button.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected. Until
+	// the meta information is loaded we cannot know whether it is.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && (!loaded || desc.getWriteProtectedFlag())) {
+		button.button->setEnabled(false);
+	} else {
+		button.button->setEnabled(true);
+	}
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
@@ -25,10 +25,59 @@
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
 
+#include "common/hashmap.h"
+#include "common/singleton.h"
+
 #include "engines/metaengine.h"
 
 namespace GUI {
 
+/**
+ * Meta information of save states as queried from the engines, kept for the
+ * whole run of ScummVM. Querying it usually means loading and decompressing
+ * the whole save file, so the save/load choosers only do so for slots not
+ * found here.
+ *
+ * All entries are dropped whenever a savefile is written or removed through
+ * the savefile manager, and each entry is also checked against the
+ * description the engine lists for its slot. The index is not written to
+ * disk: savefiles have no modification times, so there would be no way to
+ * tell whether a save changed while ScummVM was not running.
+ */
+class SaveMetaIndex : public Common::Singleton<SaveMetaIndex> {
+public:
+	/**
+	 * Look up the meta information of a listed save state.
+	 *
+	 * @return The meta information, or 0 if it is unknown or out of date.
+	 */
+	const SaveStateDescriptor *find(const Common::String &target, const SaveStateDescriptor &listed);
+
+	/**
+	 * Store the meta information of a listed save state. The thumbnail is
+	 * converted to the pixel format of the GUI.
+	 */
+	void store(const Common::String &target, const SaveStateDescriptor &listed, const SaveStateDescriptor &desc);
+
+	void invalidate(const Common::String &target, int slot);
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	SaveMetaIndex();
+
+	void checkChangeCount();
+
+	struct Entry {
+		Common::String listedDescription;
+		SaveStateDescriptor desc;
+	};
+
+	typedef Common::HashMap<int, Entry> SlotMap;
+	typedef Common::HashMap<Common::String, SlotMap, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TargetMap;
+	TargetMap _targets;
+	uint32 _changeCount;
+};
+
 #define kSwitchSaveLoadDialog -2
 
 // TODO: We might want to disable the grid based save/load chooser for more
@@ -69,6 +118,13 @@ public:
 protected:
 	virtual int runIntern() = 0;
 
+	/**
+	 * Get the meta information of a listed save state, from the index or
+	 * from the engine.
+	 */
+	SaveStateDescriptor querySaveMetaInfos(const SaveStateDescriptor &listed);
+	void removeSaveState(int slot);
+
 	const bool				_saveMode;
 	const MetaEngine		*_metaEngine;
 	bool					_delSupport;
@@ -163,6 +219,7 @@ public:
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
+	virtual void handleTickle();
 private:
 	virtual int runIntern();
 
@@ -200,6 +257,11 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &button, const SaveStateDescriptor &desc, bool loaded);
+
+	// Buttons on the current page whose meta information still has to be
+	// queried. One is filled in per tickle, so that a page shows up at once.
+	Common::Array<uint> _pendingButtons;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -102,6 +102,11 @@ int SaveLoadChooser::runModalWithPluginAndTarget(const EnginePlugin *plugin, con
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
 	} while (ret < -1);
 
+	// The caller is going to write the chosen slot, so whatever is known
+	// about it is out of date
+	if (_saveMode && ret >= 0)
+		SaveMetaIndex::instance().invalidate(target, ret);
+
 	// Revert to the old active domain
 	ConfMan.setActiveDomain(oldDomain);
 
@@ -160,6 +160,10 @@ void ListWidget::setList(const StringArray &list, const ColorList *colors) {
 	_listIndex.clear();
 	_listColors.clear();
 
+	_filterKeys = list;
+	for (StringArray::iterator i = _filterKeys.begin(); i != _filterKeys.end(); ++i)
+		i->toLowercase();
+
 	if (colors) {
 		_listColors = *colors;
 		assert(_listColors.size() == _dataList.size());
@@ -192,6 +196,9 @@ void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 	_dataList.push_back(s);
 	_list.push_back(s);
 
+	_filterKeys.push_back(s);
+	_filterKeys.back().toLowercase();
+
 	setFilter(_filter, false);
 
 	scrollBarRecalc();
@@ -670,6 +677,11 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// When the new filter only adds to the end of the old one, every entry
+	// it matches was matched by the old filter too, so only those have to
+	// be checked again. This is the common case of typing a search.
+	const bool narrowing = !_filter.empty() && filt.hasPrefix(_filter);
+
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -681,27 +693,33 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 		// as substrings, ignoring case.
 
 		Common::StringTokenizer tok(_filter);
-		String tmp;
-		int n = 0;
+		Common::Array<int> candidates;
+
+		if (narrowing) {
+			candidates = _listIndex;
+		} else {
+			candidates.resize(_dataList.size());
+			for (uint n = 0; n < _dataList.size(); ++n)
+				candidates[n] = n;
+		}
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
+		for (Common::Array<int>::const_iterator n = candidates.begin(); n != candidates.end(); ++n) {
+			const String &key = _filterKeys[*n];
 			bool matches = true;
 			tok.reset();
 			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+				if (!key.contains(tok.nextToken())) {
 					matches = false;
 					break;
 				}
 			}
 
 			if (matches) {
-				_list.push_back(*i);
-				_listIndex.push_back(n);
+				_list.push_back(_dataList[*n]);
+				_listIndex.push_back(*n);
 			}
 		}
 	}
@@ -54,6 +54,7 @@ public:
 protected:
 	StringArray		_list;
 	StringArray		_dataList;
+	StringArray		_filterKeys;	///< Lowercase copies of the _dataList entries
 	ColorList		_listColors;
 	Common::Array<int>		_listIndex;
 	bool			_editable;
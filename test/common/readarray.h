@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/substream.h"
+
+class ReadArrayTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_read_uint16() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		uint16 words[3];
+
+		TS_ASSERT_EQUALS(ms.readUint16LEArray(words, 3), (uint32)3);
+		TS_ASSERT_EQUALS(words[0], 0x0201);
+		TS_ASSERT_EQUALS(words[1], 0x0403);
+		TS_ASSERT_EQUALS(words[2], 0x0605);
+		TS_ASSERT(!ms.eos());
+
+		ms.seek(0);
+		TS_ASSERT_EQUALS(ms.readUint16BEArray(words, 3), (uint32)3);
+		TS_ASSERT_EQUALS(words[0], 0x0102);
+		TS_ASSERT_EQUALS(words[1], 0x0304);
+		TS_ASSERT_EQUALS(words[2], 0x0506);
+	}
+
+	void test_read_uint32() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		uint32 words[2];
+
+		TS_ASSERT_EQUALS(ms.readUint32LEArray(words, 2), (uint32)2);
+		TS_ASSERT_EQUALS(words[0], (uint32)0x04030201);
+		TS_ASSERT_EQUALS(words[1], (uint32)0x08070605);
+
+		ms.seek(0);
+		TS_ASSERT_EQUALS(ms.readUint32BEArray(words, 2), (uint32)2);
+		TS_ASSERT_EQUALS(words[0], (uint32)0x01020304);
+		TS_ASSERT_EQUALS(words[1], (uint32)0x05060708);
+	}
+
+	void test_read_past_end() {
+		byte contents[] = { 1, 2, 3, 4, 5 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		uint16 words[4];
+
+		// Only complete words are counted
+		TS_ASSERT_EQUALS(ms.readUint16BEArray(words, 4), (uint32)2);
+		TS_ASSERT_EQUALS(words[0], 0x0102);
+		TS_ASSERT_EQUALS(words[1], 0x0304);
+		TS_ASSERT(ms.eos());
+	}
+
+	void test_matches_single_reads() {
+		// Long enough to go through the vectorized swaps, with an odd
+		// count and offset to also cover the remaining words.
+		byte contents[1031];
+		for (uint i = 0; i < sizeof(contents); i++)
+			contents[i] = (byte)(i * 7 + 3);
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		Common::SeekableSubReadStream sub(&ms, 1, sizeof(contents));
+		uint16 words16[515];
+		uint32 words32[257];
+
+		TS_ASSERT_EQUALS(sub.readUint16BEArray(words16, 515), (uint32)515);
+		sub.seek(0);
+		for (uint i = 0; i < 515; i++)
+			TS_ASSERT_EQUALS(words16[i], sub.readUint16BE());
+
+		sub.seek(0);
+		TS_ASSERT_EQUALS(sub.readUint16LEArray(words16, 515), (uint32)515);
+		sub.seek(0);
+		for (uint i = 0; i < 515; i++)
+			TS_ASSERT_EQUALS(words16[i], sub.readUint16LE());
+
+		sub.seek(0);
+		TS_ASSERT_EQUALS(sub.readUint32BEArray(words32, 257), (uint32)257);
+		sub.seek(0);
+		for (uint i = 0; i < 257; i++)
+			TS_ASSERT_EQUALS(words32[i], sub.readUint32BE());
+
+		sub.seek(0);
+		TS_ASSERT_EQUALS(sub.readUint32LEArray(words32, 257), (uint32)257);
+		sub.seek(0);
+		for (uint i = 0; i < 257; i++)
+			TS_ASSERT_EQUALS(words32[i], sub.readUint32LE());
+	}
+
+	void test_memory_stream_end() {
+		byte contents[] = { 1, 2, 3 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		TS_ASSERT_EQUALS(ms.readUint16BE(), 0x0102);
+		TS_ASSERT(!ms.eos());
+		ms.readUint16BE();
+		TS_ASSERT(ms.eos());
+
+		ms.seek(2);
+		TS_ASSERT_EQUALS(ms.readByte(), 3);
+		TS_ASSERT(!ms.eos());
+		TS_ASSERT_EQUALS(ms.readByte(), 0);
+		TS_ASSERT(ms.eos());
+	}
+
+	void test_endian_stream() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6 };
+		Common::MemoryReadStreamEndian le(contents, sizeof(contents), false);
+		Common::MemoryReadStreamEndian be(contents, sizeof(contents), true);
+		uint16 words[3];
+
+		TS_ASSERT_EQUALS(le.readUint16(), 0x0201);
+		TS_ASSERT_EQUALS(le.readUint32(), (uint32)0x06050403);
+		TS_ASSERT_EQUALS(be.readUint16Array(words, 3), (uint32)3);
+		TS_ASSERT_EQUALS(words[2], 0x0506);
+	}
+};
@@ -0,0 +1,99 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "graphics/fonts/winfont.h"
+
+class FontTestSuite : public CxxTest::TestSuite
+{
+	/**
+	 * Build a Windows 2.0 raster font with the glyphs 'A' and 'B', both
+	 * completely filled and charWidth pixels wide.
+	 */
+	static void writeFNT(Common::WriteStream &stream, uint16 charWidth, uint16 height) {
+		const byte firstChar = 'A', lastChar = 'B';
+		const int glyphCount = lastChar - firstChar + 2;
+		const int headerSize = 118;
+		const int bitmapSize = ((charWidth + 7) / 8) * height;
+
+		stream.writeUint16LE(0x200);         // version
+		stream.writeUint32LE(0);             // size
+		for (int i = 0; i < 60; i++)         // copyright
+			stream.writeByte(0);
+		stream.writeUint16LE(0);             // type: raster
+		stream.writeUint16LE(height);        // points
+		stream.writeUint16LE(96);            // vertical resolution
+		stream.writeUint16LE(96);            // horizontal resolution
+		stream.writeUint16LE(height);        // ascent
+		stream.writeUint16LE(0);             // internal leading
+		stream.writeUint16LE(0);             // external leading
+		stream.writeByte(0);                 // italic
+		stream.writeByte(0);                 // underline
+		stream.writeByte(0);                 // strike out
+		stream.writeUint16LE(400);           // weight
+		stream.writeByte(0);                 // char set
+		stream.writeUint16LE(0);             // pixel width: variable
+		stream.writeUint16LE(height);        // pixel height
+		stream.writeByte(0);                 // pitch and family
+		stream.writeUint16LE(charWidth);     // average width
+		stream.writeUint16LE(charWidth);     // maximum width
+		stream.writeByte(firstChar);
+		stream.writeByte(lastChar);
+		stream.writeByte(firstChar);         // default char
+		stream.writeByte(' ');               // break char
+		stream.writeUint16LE(0);             // width bytes
+		stream.writeUint32LE(0);             // device
+		stream.writeUint32LE(0);             // face
+		stream.writeUint32LE(0);             // bits pointer
+		stream.writeUint32LE(0);             // bits offset
+		stream.writeByte(0);                 // reserved
+
+		// The last glyph is the sentinel, which has no bitmap of its own
+		const int bitmapStart = headerSize + glyphCount * 4;
+		for (int i = 0; i < glyphCount; i++) {
+			stream.writeUint16LE(charWidth);
+			stream.writeUint16LE(bitmapStart + MIN(i, glyphCount - 2) * bitmapSize);
+		}
+
+		for (int i = 0; i < (glyphCount - 1) * bitmapSize; i++)
+			stream.writeByte(0xFF);
+	}
+
+	static bool loadFont(Graphics::WinFont &font, uint16 charWidth, uint16 height) {
+		Common::MemoryWriteStreamDynamic data(DisposeAfterUse::YES);
+		writeFNT(data, charWidth, height);
+
+		Common::MemoryReadStream stream(data.getData(), data.size());
+		return font.loadFromFNT(stream);
+	}
+
+	static int countSetPixels(const Graphics::Surface &surface) {
+		int count = 0;
+		for (int x = 0; x < surface.w; x++) {
+			if (*(const byte *)surface.getBasePtr(x, 0))
+				count++;
+		}
+		return count;
+	}
+
+	public:
+	void test_winfont_reload() {
+		Graphics::WinFont font;
+		Graphics::Surface surface;
+		surface.create(64, 8, Graphics::PixelFormat::createFormatCLUT8());
+		memset(surface.pixels, 0, surface.pitch * surface.h);
+
+		TS_ASSERT(loadFont(font, 2, 4));
+		font.drawString(&surface, "AB", 0, 0, surface.w, 1);
+		TS_ASSERT_EQUALS(countSetPixels(surface), 4);
+
+		// The layout of "AB" drawn with the old font must not be reused
+		memset(surface.pixels, 0, surface.pitch * surface.h);
+		TS_ASSERT(loadFont(font, 5, 6));
+		font.drawString(&surface, "AB", 0, 0, surface.w, 1);
+		TS_ASSERT_EQUALS(countSetPixels(surface), 10);
+		TS_ASSERT_EQUALS(font.getStringWidth("AB"), 10);
+
+		surface.free();
+	}
+};
@@ -0,0 +1,50 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scaler/intern.h"
+
+class ScalerTestSuite : public CxxTest::TestSuite
+{
+	static int makeYUV(int y, int u, int v) {
+		return (y << 16) | (u << 8) | v;
+	}
+
+	static int referencePattern(int yuv5, const int *yuv) {
+		int pattern = 0;
+		for (int i = 0; i < 8; i++) {
+			if (diffYUV(yuv5, yuv[i]))
+				pattern |= 1 << i;
+		}
+		return pattern;
+	}
+
+	public:
+	void test_hqPattern() {
+		// Differences right around the Y, U and V thresholds of diffYUV()
+		static const int deltas[] = { -255, -49, -48, -47, -8, -7, -6, -5, -1, 0, 1, 5, 6, 7, 8, 47, 48, 49, 255 };
+		static const int numDeltas = ARRAYSIZE(deltas);
+		static const int centers[] = { 0, 6, 48, 128, 191, 255 };
+		static const int numCenters = ARRAYSIZE(centers);
+
+		for (int c = 0; c < numCenters * numCenters * numCenters; c++) {
+			const int y = centers[c % numCenters];
+			const int u = centers[(c / numCenters) % numCenters];
+			const int v = centers[c / (numCenters * numCenters)];
+			const int yuv5 = makeYUV(y, u, v);
+
+			for (int d = 0; d < numDeltas * numDeltas * numDeltas; d++) {
+				int yuv[8];
+
+				// Spread the deltas over the components and neighbours, so that
+				// every neighbour gets a different combination
+				for (int i = 0; i < 8; i++) {
+					const int n = d + i * 7;
+					yuv[i] = makeYUV(CLIP(y + deltas[n % numDeltas], 0, 255),
+					                 CLIP(u + deltas[(n / numDeltas) % numDeltas], 0, 255),
+					                 CLIP(v + deltas[(n / (numDeltas * numDeltas)) % numDeltas], 0, 255));
+				}
+
+				TS_ASSERT_EQUALS(hqPattern(yuv5, yuv[0], yuv[1], yuv[2], yuv[3], yuv[4], yuv[5], yuv[6], yuv[7]), referencePattern(yuv5, yuv));
+			}
+		}
+	}
+};
@@ -28,6 +28,7 @@
 #include "audio/decoders/raw.h"
 
 #include "common/util.h"
+#include "common/debug.h"
 #include "common/textconsole.h"
 #include "common/math.h"
 #include "common/stream.h"
@@ -63,6 +64,7 @@ namespace Video {
 
 BinkDecoder::BinkDecoder() {
 	_bink = 0;
+	_seeking = false;
 }
 
 BinkDecoder::~BinkDecoder() {
@@ -154,6 +156,63 @@ void BinkDecoder::close() {
 
 	_audioTracks.clear();
 	_frames.clear();
+	_keyFrames.clear();
+}
+
+bool BinkDecoder::rewind() {
+	return seek(Audio::Timestamp(0, 1000));
+}
+
+bool BinkDecoder::seek(const Audio::Timestamp &time) {
+	if (!isSeekable())
+		return false;
+
+	BinkVideoTrack *videoTrack = (BinkVideoTrack *)getTrack(0);
+
+	uint32 startTime = g_system->getMillis();
+
+	uint32 targetFrame = MIN<uint32>(videoTrack->getFrameAtTime(time), _frames.size() - 1);
+	uint32 keyFrame = findKeyFrame(targetFrame);
+
+	// Decode forward from the key frame up to the frame before the one
+	// we want to show. The audio packets of these frames are skipped, the
+	// audio tracks start again at the target frame.
+	videoTrack->setCurFrame(keyFrame - 1);
+
+	_seeking = true;
+	while (videoTrack->getCurFrame() < (int)targetFrame - 1)
+		readNextPacket();
+	_seeking = false;
+
+	debug(3, "BinkDecoder::seek(): Seeked to frame %d from key frame %d in %d ms", targetFrame, keyFrame, g_system->getMillis() - startTime);
+
+	return VideoDecoder::seek(time);
+}
+
+uint32 BinkDecoder::findKeyFrame(uint32 frame) {
+	if (_frames.empty())
+		return 0;
+
+	if (_keyFrames.empty()) {
+		// The first frame is always a key frame
+		for (uint32 i = 0; i < _frames.size(); i++)
+			if (i == 0 || _frames[i].keyFrame)
+				_keyFrames.push_back(i);
+	}
+
+	// Binary search for the last key frame at or before the given frame
+	uint32 low = 0, high = _keyFrames.size();
+
+	while (high - low > 1) {
+		uint32 mid = (low + high) / 2;
+
+		if (_keyFrames[mid] <= frame)
+			low = mid;
+		else
+			high = mid;
+	}
+
+	return _keyFrames[low];
 }
 
 void BinkDecoder::readNextPacket() {
@@ -179,7 +238,11 @@ void BinkDecoder::readNextPacket() {
 		if (frameSize < audioPacketLength)
 			error("Audio packet too big for the frame");
 
-		if (audioPacketLength >= 4) {
+		if (audioPacketLength >= 4 && _seeking) {
+			_bink->skip(audioPacketLength);
+
+			frameSize -= audioPacketLength;
+		} else if (audioPacketLength >= 4) {
 			// Get our track - audio index plus one as the first track is video
 			BinkAudioTrack *audioTrack = (BinkAudioTrack *)getTrack(i + 1);
 			uint32 audioPacketStart = _bink->pos();
@@ -1353,6 +1416,16 @@ Audio::AudioStream *BinkDecoder::BinkAudioTrack::getAudioStream() const {
 	return _audioStream;
 }
 
+bool BinkDecoder::BinkAudioTrack::seek(const Audio::Timestamp &time) {
+	// The decoder has already skipped the audio packets before the target
+	// frame, so just drop whatever is still queued and start over
+	delete _audioStream;
+	_audioStream = Audio::makeQueuingAudioStream(_audioInfo->outSampleRate, _audioInfo->outChannels == 2);
+
+	_audioInfo->first = true;
+	return true;
+}
+
 void BinkDecoder::BinkAudioTrack::decodePacket() {
 	int outSize = _audioInfo->frameLen * _audioInfo->channels;
 
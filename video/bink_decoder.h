@@ -72,6 +72,9 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	bool rewind();
+	bool seek(const Audio::Timestamp &time);
+
 protected:
 	void readNextPacket();
 
@@ -149,6 +152,13 @@ private:
 		int getFrameCount() const { return _frameCount; }
 		const Graphics::Surface *decodeNextFrame() { return &_surface; }
 
+		// The actual seeking is done by BinkDecoder::seek(), which owns the stream
+		bool isSeekable() const { return true; }
+		bool seek(const Audio::Timestamp &time) { return true; }
+
+		void setCurFrame(int frame) { _curFrame = frame; }
+		uint getFrameAtTime(const Audio::Timestamp &time) const { return FixedRateVideoTrack::getFrameAtTime(time); }
+
 		/** Decode a video packet. */
 		void decodePacket(VideoFrame &frame);
 
@@ -321,6 +331,9 @@ private:
 		BinkAudioTrack(AudioInfo &audio);
 		~BinkAudioTrack();
 
+		bool isSeekable() const { return true; }
+		bool seek(const Audio::Timestamp &time);
+
 		/** Decode an audio packet. */
 		void decodePacket();
 
@@ -349,8 +362,14 @@ private:
 
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
+	Common::Array<uint32> _keyFrames;       ///< Indices of all key frames, built on the first seek.
+
+	bool _seeking; ///< Are we decoding forward to a seek target?
 
 	void initAudioTrack(AudioInfo &audio);
+
+	/** Find the last key frame at or before the given frame. */
+	uint32 findKeyFrame(uint32 frame);
 };
 
 } // End of namespace Video
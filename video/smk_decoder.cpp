@@ -32,6 +32,7 @@
 #include "common/memstream.h"
 #include "common/bitstream.h"
 #include "common/system.h"
+#include "common/debug.h"
 #include "common/textconsole.h"
 
 #include "audio/audiostream.h"
@@ -282,6 +283,7 @@ SmackerDecoder::SmackerDecoder(Audio::Mixer::SoundType soundType) : _soundType(s
 	_firstFrameStart = 0;
 	_frameTypes = 0;
 	_frameSizes = 0;
+	_seeking = false;
 }
 
 SmackerDecoder::~SmackerDecoder() {
@@ -406,6 +408,9 @@ void SmackerDecoder::close() {
 
 	delete[] _frameSizes;
 	_frameSizes = 0;
+
+	_frameOffsets.clear();
+	_keyFrames.clear();
 }
 
 bool SmackerDecoder::rewind() {
@@ -418,6 +423,86 @@ bool SmackerDecoder::rewind() {
 	return true;
 }
 
+bool SmackerDecoder::seek(const Audio::Timestamp &time) {
+	if (!isSeekable())
+		return false;
+
+	SmackerVideoTrack *videoTrack = (SmackerVideoTrack *)getTrack(0);
+
+	if (videoTrack->getFrameCount() == 0)
+		return false;
+
+	uint32 startTime = g_system->getMillis();
+
+	buildSeekIndex();
+
+	uint32 targetFrame = MIN<uint32>(videoTrack->getFrameAtTime(time), videoTrack->getFrameCount() - 1);
+	uint32 keyFrame = findKeyFrame(targetFrame);
+
+	// Palette records are delta-coded against the previous palette, so
+	// replay all of them up to the key frame
+	videoTrack->resetPalette();
+	for (uint32 i = 0; i < keyFrame; i++) {
+		if (_frameTypes[i] & 1) {
+			_fileStream->seek(_frameOffsets[i]);
+			videoTrack->unpackPalette(_fileStream);
+		}
+	}
+
+	// Decode forward from the key frame up to the frame before the one
+	// we want to show. Audio is not queued for these frames, the audio
+	// track starts again at the target frame.
+	_fileStream->seek(_frameOffsets[keyFrame]);
+	videoTrack->setCurFrame(keyFrame - 1);
+
+	_seeking = true;
+	while (videoTrack->getCurFrame() < (int)targetFrame - 1)
+		readNextPacket();
+	_seeking = false;
+
+	debug(3, "SmackerDecoder::seek(): Seeked to frame %d from key frame %d in %d ms", targetFrame, keyFrame, g_system->getMillis() - startTime);
+
+	return VideoDecoder::seek(time);
+}
+
+void SmackerDecoder::buildSeekIndex() {
+	if (!_frameOffsets.empty())
+		return;
+
+	uint32 frameCount = ((SmackerVideoTrack *)getTrack(0))->getFrameCount();
+	uint32 offset = _firstFrameStart;
+
+	_frameOffsets.resize(frameCount);
+
+	for (uint32 i = 0; i < frameCount; i++) {
+		_frameOffsets[i] = offset;
+		offset += _frameSizes[i] & ~3;
+
+		// The first frame is always a key frame
+		if (i == 0 || (_frameSizes[i] & 1))
+			_keyFrames.push_back(i);
+	}
+}
+
+uint32 SmackerDecoder::findKeyFrame(uint32 frame) const {
+	if (_keyFrames.empty())
+		return 0;
+
+	// Binary search for the last key frame at or before the given frame
+	uint32 low = 0, high = _keyFrames.size();
+
+	while (high - low > 1) {
+		uint32 mid = (low + high) / 2;
+
+		if (_keyFrames[mid] <= frame)
+			low = mid;
+		else
+			high = mid;
+	}
+
+	return _keyFrames[low];
+}
+
 void SmackerDecoder::readNextPacket() {
 	SmackerVideoTrack *videoTrack = (SmackerVideoTrack *)getTrack(0);
 
@@ -477,7 +562,7 @@ void SmackerDecoder::readNextPacket() {
 }
 
 void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize) {
-	if (_header.audioInfo[track].hasAudio && chunkSize > 0 && track == 0) {
+	if (_header.audioInfo[track].hasAudio && chunkSize > 0 && track == 0 && !_seeking) {
 		// Get the audio track, which start at offset 1 (first track is video)
 		SmackerAudioTrack *audioTrack = (SmackerAudioTrack *)getTrack(track + 1);
 
@@ -745,6 +830,11 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 	_dirtyPalette = true;
 }
 
+void SmackerDecoder::SmackerVideoTrack::resetPalette() {
+	memset(_palette, 0, 3 * 256);
+	_dirtyPalette = true;
+}
+
 SmackerDecoder::SmackerAudioTrack::SmackerAudioTrack(const AudioInfo &audioInfo, Audio::Mixer::SoundType soundType) :
 		_audioInfo(audioInfo), _soundType(soundType) {
 	_audioStream = Audio::makeQueuingAudioStream(_audioInfo.sampleRate, _audioInfo.isStereo);
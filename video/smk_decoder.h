@@ -23,6 +23,7 @@
 #ifndef VIDEO_SMK_PLAYER_H
 #define VIDEO_SMK_PLAYER_H
 
+#include "common/array.h"
 #include "common/rational.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
@@ -66,6 +67,7 @@ public:
 	void close();
 
 	bool rewind();
+	bool seek(const Audio::Timestamp &time);
 
 protected:
 	void readNextPacket();
@@ -80,6 +82,10 @@ protected:
 		bool isRewindable() const { return true; }
 		bool rewind() { _curFrame = -1; return true; }
 
+		// The actual seeking is done by SmackerDecoder::seek(), which owns the stream
+		bool isSeekable() const { return true; }
+		bool seek(const Audio::Timestamp &time) { return true; }
+
 		uint16 getWidth() const;
 		uint16 getHeight() const;
 		Graphics::PixelFormat getPixelFormat() const;
@@ -91,8 +97,11 @@ protected:
 
 		void readTrees(Common::BitStream &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize);
 		void increaseCurFrame() { _curFrame++; }
+		void setCurFrame(int frame) { _curFrame = frame; }
+		uint getFrameAtTime(const Audio::Timestamp &time) const { return FixedRateVideoTrack::getFrameAtTime(time); }
 		void decodeFrame(Common::BitStream &bs);
 		void unpackPalette(Common::SeekableReadStream *stream);
+		void resetPalette();
 
 	protected:
 		Common::Rational getFrameRate() const { return _frameRate; }
@@ -159,6 +168,9 @@ private:
 		bool isRewindable() const { return true; }
 		bool rewind();
 
+		bool isSeekable() const { return true; }
+		bool seek(const Audio::Timestamp &time) { return rewind(); }
+
 		Audio::Mixer::SoundType getSoundType() const { return _soundType; }
 
 		void queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize);
@@ -183,6 +195,16 @@ private:
 
 	uint32 _firstFrameStart;
 
+	// Seek index, built on the first seek from the frame size table. Bit 0
+	// of each frame size marks a key frame, which can be decoded without
+	// any of the preceding frames.
+	Common::Array<uint32> _frameOffsets;
+	Common::Array<uint32> _keyFrames;
+	bool _seeking;
+
+	void buildSeekIndex();
+	uint32 findKeyFrame(uint32 frame) const;
+
 	Audio::Mixer::SoundType _soundType;
 };
 